@@ -0,0 +1,61 @@
+#include <indicators/display_width.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// Measures unicode::display_width() over ASCII, mixed and CJK text, next to a
+// loop that looks up every code point, which is what display_width() does
+// for text that is not printable ASCII.
+
+static int width_per_code_point(const std::string &text) {
+  using namespace unicode::details;
+  int width = 0;
+  for (const char *it = text.data(), *end = it + text.size(); it != end;) {
+    const int w = mk_wcwidth(utf8_next(it, end));
+    if (w < 0)
+      return -1;
+    width += w;
+  }
+  return width;
+}
+
+template <typename Measure> double nanoseconds_per_byte(const std::string &text, Measure measure) {
+  const size_t iterations = 2000000 / text.size() + 1;
+  long long total = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i)
+    total += measure(text);
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  if (total == 0)
+    std::printf("unexpected zero width\n");
+  return elapsed.count() / (double(iterations) * text.size());
+}
+
+static std::string repeat(const std::string &text, size_t times) {
+  std::string result;
+  for (size_t i = 0; i < times; ++i)
+    result += text;
+  return result;
+}
+
+int main() {
+  struct Corpus {
+    const char *name;
+    std::string text;
+  } corpora[] = {
+      {"ascii", repeat("Downloading archive-2024.tar.gz [eta 00m:12s] ", 8)},
+      {"mixed", repeat("Extracting fichier_été.txt → 中文/ █▉▊ ", 8)},
+      {"cjk", repeat("進捗状況を表示しています中文字符", 8)},
+  };
+
+  std::printf("%-8s %8s %18s %18s\n", "corpus", "bytes", "per code point ns/B",
+              "display_width ns/B");
+  for (const auto &corpus : corpora) {
+    const double lookup = nanoseconds_per_byte(corpus.text, width_per_code_point);
+    const double measured = nanoseconds_per_byte(
+        corpus.text, [](const std::string &text) { return unicode::display_width(text); });
+    std::printf("%-8s %8zu %18.3f %18.3f\n", corpus.name, corpus.text.size(), lookup, measured);
+  }
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <indicators/multi_progress.hpp>
+#include <indicators/progress_bar.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Swallows everything written to it, counting the bytes and the writes, so
+// that the cost of a frame shows without the cost of the terminal
+class CountingBuffer : public std::streambuf {
+public:
+  size_t bytes{0};
+  size_t writes{0};
+
+protected:
+  int overflow(int c) override {
+    ++bytes;
+    ++writes;
+    return c;
+  }
+  std::streamsize xsputn(const char *, std::streamsize n) override {
+    bytes += static_cast<size_t>(n);
+    ++writes;
+    return n;
+  }
+};
+
+// Draws a MultiProgress of count bars, then ticks each bar ticks_per_bar
+// times in random order, each tick moving the percentage of its bar and
+// drawing a frame, and reports the cost of the first frame and of a tick
+void run(size_t count, size_t ticks_per_bar) {
+  using namespace indicators;
+  CountingBuffer buffer;
+  std::ostream stream(&buffer);
+
+  std::vector<std::unique_ptr<ProgressBar>> tasks;
+  tasks.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    tasks.emplace_back(new ProgressBar{
+        option::BarWidth{40}, option::MaxProgress{100}, option::ShowPercentage{true},
+        option::PrefixText{"task " + std::to_string(i) + " "}, option::Stream{stream}});
+  MultiProgress<ProgressBar> bars(tasks.begin(), tasks.end());
+
+  auto start = std::chrono::steady_clock::now();
+  bars.print_progress();
+  std::chrono::duration<double> first = std::chrono::steady_clock::now() - start;
+  const size_t first_bytes = buffer.bytes;
+
+  std::vector<size_t> order;
+  order.reserve(count * ticks_per_bar);
+  for (size_t i = 0; i < count; ++i)
+    order.insert(order.end(), ticks_per_bar, i);
+  std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  const size_t ticks = order.size();
+
+  buffer.bytes = 0;
+  buffer.writes = 0;
+  start = std::chrono::steady_clock::now();
+  for (auto index : order)
+    bars.tick(index);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::printf("%6zu bars: first frame %8.2f ms %9zu bytes | tick + frame %7.0f ns "
+              "%6.1f bytes %4.2f writes\n",
+              count, first.count() * 1e3, first_bytes, elapsed.count() * 1e9 / ticks,
+              double(buffer.bytes) / ticks, double(buffer.writes) / ticks);
+}
+
+} // namespace
+
+int main() {
+  const size_t ticks_per_bar = 20;
+  for (size_t count : {10, 100, 1000, 10000})
+    run(count, ticks_per_bar);
+  return 0;
+}
@@ -0,0 +1,23 @@
+#ifndef INDICATORS_BENCHMARKS_NULL_STREAM
+#define INDICATORS_BENCHMARKS_NULL_STREAM
+
+#include <ostream>
+#include <streambuf>
+
+// Swallows everything written to it, so that the benchmarks measure the cost
+// of the indicators and not the cost of the terminal.
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override { return c; }
+  std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+class NullStream : public std::ostream {
+public:
+  NullStream() : std::ostream(&buffer_) {}
+
+private:
+  NullBuffer buffer_;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "null_stream.hpp"
+
+#include <indicators/details/number_format.hpp>
+#include <indicators/details/stream_helper.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <locale>
+#include <string>
+
+// Formats the same values through the iostream helpers the indicators used to
+// call and through the FrameBuffer formatters, and reports the cost per call.
+
+// Groups digits in threes, the iostream way of writing 1,234,567
+class ThousandsSeparator : public std::numpunct<char> {
+protected:
+  char do_thousands_sep() const override { return ','; }
+  std::string do_grouping() const override { return "\3"; }
+};
+
+static const size_t iterations = 1000000;
+
+template <typename Format> double nanoseconds_per_call(Format format) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i)
+    format(i);
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+static void report(const char *what, double iostream_ns, double buffer_ns) {
+  std::printf("%-12s %14.1f %14.1f %9.1fx\n", what, iostream_ns, buffer_ns,
+              iostream_ns / buffer_ns);
+}
+
+int main() {
+  using namespace indicators;
+
+  NullStream stream;
+  details::FrameBuffer frame;
+  size_t written = 0;
+
+  std::printf("%-12s %14s %14s %10s\n", "", "iostream ns", "buffer ns", "speedup");
+
+  const auto duration_of = [](size_t i) {
+    return std::chrono::nanoseconds(static_cast<long long>(i) * 7919 * 1000000);
+  };
+  report("duration",
+         nanoseconds_per_call([&](size_t i) { details::write_duration(stream, duration_of(i)); }),
+         nanoseconds_per_call([&](size_t i) {
+           frame.clear();
+           details::write_duration(frame, duration_of(i));
+           written += frame.size();
+         }));
+
+  report("percentage",
+         nanoseconds_per_call([&](size_t i) { stream << (i % 101) << "%"; }),
+         nanoseconds_per_call([&](size_t i) {
+           frame.clear();
+           details::write_percentage(frame, double(i % 101));
+           written += frame.size();
+         }));
+
+  report("integer",
+         nanoseconds_per_call([&](size_t i) { stream << i * 7919; }),
+         nanoseconds_per_call([&](size_t i) {
+           frame.clear();
+           details::write_unsigned(frame, i * 7919);
+           written += frame.size();
+         }));
+
+  NullStream grouped_stream;
+  grouped_stream.imbue(std::locale(grouped_stream.getloc(), new ThousandsSeparator));
+  report("count",
+         nanoseconds_per_call([&](size_t i) { grouped_stream << i * 7919; }),
+         nanoseconds_per_call([&](size_t i) {
+           frame.clear();
+           details::write_count(frame, i * 7919);
+           written += frame.size();
+         }));
+
+  report("rate",
+         nanoseconds_per_call([&](size_t i) {
+           stream << std::fixed << std::setprecision(1) << i * 0.37 << "/s";
+         }),
+         nanoseconds_per_call([&](size_t i) {
+           frame.clear();
+           details::write_rate(frame, i * 0.37);
+           written += frame.size();
+         }));
+
+  // Keeps the buffer formatting from being optimised away
+  return written == 0;
+}
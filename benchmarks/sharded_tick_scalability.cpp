@@ -0,0 +1,54 @@
+#include "null_stream.hpp"
+
+#include <indicators/progress_bar.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+double ticks_per_second(size_t threads, size_t ticks_per_thread, bool sharded,
+                        std::ostream &stream) {
+  using namespace indicators;
+  ProgressBar bar{option::BarWidth{50}, option::ShowPercentage{true},
+                  option::MaxProgress{threads * ticks_per_thread},
+                  option::MinRedrawInterval{std::chrono::milliseconds(100)},
+                  option::ShardedProgress{sharded}, option::Stream{stream}};
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < threads; ++i)
+    workers.emplace_back([&bar, ticks_per_thread]() {
+      for (size_t j = 0; j < ticks_per_thread; ++j)
+        bar.tick();
+    });
+  for (auto &worker : workers)
+    worker.join();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return threads * ticks_per_thread / elapsed.count();
+}
+
+} // namespace
+
+int main() {
+  const size_t ticks_per_thread = 2000000;
+  const size_t cores = (std::max)(1u, std::thread::hardware_concurrency());
+  NullStream stream;
+
+  std::vector<size_t> thread_counts;
+  for (size_t threads = 1; threads < cores; threads *= 2)
+    thread_counts.push_back(threads);
+  thread_counts.push_back(cores);
+
+  std::printf("%8s %18s %18s\n", "threads", "atomic ticks/sec", "sharded ticks/sec");
+  for (auto threads : thread_counts) {
+    const auto atomic = ticks_per_second(threads, ticks_per_thread, false, stream);
+    const auto sharded = ticks_per_second(threads, ticks_per_thread, true, stream);
+    std::printf("%8zu %18.0f %18.0f\n", threads, atomic, sharded);
+  }
+
+  return 0;
+}
@@ -0,0 +1,37 @@
+#include "null_stream.hpp"
+
+#include <indicators/progress_bar.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+int main() {
+  using namespace indicators;
+
+  const size_t ticks_per_thread = 50000;
+  NullStream stream;
+
+  std::printf("%8s %14s %16s\n", "threads", "ticks", "ticks/sec");
+  for (size_t threads : {1, 4, 16}) {
+    ProgressBar bar{option::BarWidth{50}, option::ShowPercentage{true},
+                    option::MaxProgress{threads * ticks_per_thread}, option::Stream{stream}};
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < threads; ++i)
+      workers.emplace_back([&bar, ticks_per_thread]() {
+        for (size_t j = 0; j < ticks_per_thread; ++j)
+          bar.tick();
+      });
+    for (auto &worker : workers)
+      worker.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto ticks = threads * ticks_per_thread;
+    std::printf("%8zu %14zu %16.0f\n", threads, ticks, ticks / elapsed.count());
+  }
+
+  return 0;
+}
@@ -3,16 +3,19 @@
 #define INDICATORS_BLOCK_PROGRESS_BAR
 
 #include <indicators/color.hpp>
+#include <indicators/details/frame_buffer.hpp>
+#include <indicators/details/redraw_throttle.hpp>
 #include <indicators/details/stream_helper.hpp>
+#include <indicators/details/width_cache.hpp>
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <indicators/render_scheduler.hpp>
 #include <indicators/setting.hpp>
 #include <indicators/terminal_size.hpp>
 #include <iomanip>
 #include <iostream>
-#include <sstream>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -26,7 +29,7 @@ class BlockProgressBar {
                               option::PrefixText, option::PostfixText, option::ShowPercentage,
                               option::ShowElapsedTime, option::ShowRemainingTime, option::Completed,
                               option::SavedStartTime, option::MaxPostfixTextLen, option::FontStyles,
-                              option::MaxProgress, option::Stream>;
+                              option::MaxProgress, option::Stream, option::MinRedrawInterval>;
 
 public:
   template <typename... Args,
@@ -63,7 +66,15 @@ public:
                   details::get<details::ProgressBarOption::max_progress>(
                       option::MaxProgress{100}, std::forward<Args>(args)...),
                   details::get<details::ProgressBarOption::stream>(option::Stream{std::cout},
-                                                                   std::forward<Args>(args)...)) {}
+                                                                   std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::min_redraw_interval>(
+                      option::MinRedrawInterval{std::chrono::nanoseconds::zero()},
+                      std::forward<Args>(args)...)) {}
+
+  ~BlockProgressBar() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
 
   template <typename T, details::ProgressBarOption id>
   void set_option(details::Setting<T, id> &&setting) {
@@ -72,6 +83,10 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = std::move(setting).value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    text_widths_.invalidate(id);
+    ++settings_version_;
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -81,6 +96,10 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = setting.value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    text_widths_.invalidate(id);
+    ++settings_version_;
   }
 
   void set_option(
@@ -90,6 +109,8 @@ public:
     if (setting.value.length() > get_value<details::ProgressBarOption::max_postfix_text_len>()) {
       get_value<details::ProgressBarOption::max_postfix_text_len>() = setting.value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
   void
@@ -100,6 +121,8 @@ public:
     if (new_value.length() > get_value<details::ProgressBarOption::max_postfix_text_len>()) {
       get_value<details::ProgressBarOption::max_postfix_text_len>() = new_value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
   void set_progress(size_t value) {
@@ -108,16 +131,19 @@ public:
       tick_ = value;
     }
     save_start_time();
-    print_progress();
+    print_progress_if_due(value);
   }
 
-  void tick() {
+  void tick() { advance(1); }
+
+  void advance(size_t n) {
+    size_t value;
     {
       std::lock_guard<std::mutex> lock{mutex_};
-      tick_++;
+      value = tick_ += n;
     }
     save_start_time();
-    print_progress();
+    print_progress_if_due(value);
   }
 
   size_t current() {
@@ -129,7 +155,7 @@ public:
 
   void mark_as_completed() {
     get_value<details::ProgressBarOption::completed>() = true;
-    print_progress();
+    print_progress_if_changed();
   }
 
 private:
@@ -149,11 +175,42 @@ private:
   size_t tick_{0};
   std::chrono::time_point<std::chrono::high_resolution_clock> start_time_point_;
   std::mutex mutex_;
+  details::RedrawThrottle throttle_;
+  // Bumped by set_option() so that a changed setting forces a redraw;
+  // starts ahead of last_state_ so that the first frame is always drawn.
+  size_t settings_version_{1};
+  details::VisibleState last_state_;
+  details::FrameBuffer frame_;
+  // Rebuilt before the next frame whenever set_option() changes the colour
+  // or font styles
+  details::StylePrefix style_;
+  bool style_stale_{true};
+  // Display widths of the prefix, postfix, start and end texts
+  details::TextWidths text_widths_;
 
   template <typename Indicator, size_t count> friend class MultiProgress;
   template <typename Indicator> friend class DynamicProgress;
   std::atomic<bool> multi_progress_mode_{false};
 
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  // Frames arriving faster than MinRedrawInterval are skipped, and frames of a
+  // bar attached to the RenderScheduler are left to it; the frame that fills
+  // the bar is always drawn.
+  void print_progress_if_due(size_t value) {
+    if (value < get_value<details::ProgressBarOption::max_progress>()) {
+      if (render_scheduled_) {
+        RenderScheduler::instance().notify(render_pending_);
+        return;
+      }
+      if (!throttle_.is_due(get_value<details::ProgressBarOption::min_redraw_interval>()))
+        return;
+    }
+    print_progress_if_changed();
+  }
+
   void save_start_time() {
     auto &show_elapsed_time = get_value<details::ProgressBarOption::show_elapsed_time>();
     auto &saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
@@ -164,24 +221,62 @@ private:
     }
   }
 
-  std::pair<std::string, int> get_prefix_text() {
-    std::stringstream os;
-    os << get_value<details::ProgressBarOption::prefix_text>();
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+  std::chrono::nanoseconds elapsed_time() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start_time_point_);
   }
 
-  std::pair<std::string, int> get_postfix_text() {
-    std::stringstream os;
-    const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
-    progress_ = static_cast<float>(tick_)/max_progress;
-    auto now = std::chrono::high_resolution_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_point_);
+  std::chrono::nanoseconds remaining_time(std::chrono::nanoseconds elapsed) const {
+    auto eta = std::chrono::nanoseconds(
+        tick_ > 0 ? static_cast<long long>(std::ceil(float(elapsed.count()) / progress_)) : 0);
+    return eta > elapsed ? (eta - elapsed) : (elapsed - eta);
+  }
+
+  details::VisibleState visible_state(std::chrono::nanoseconds elapsed) const {
+    const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
+    const auto saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
+    auto value = (std::min)(1.0f, (std::max)(0.0f, progress_));
+    auto whole_width = std::floor(value * bar_width);
+    auto part_width = std::floor(fmod((value * bar_width), 1.0f) * 8);
+
+    details::VisibleState state;
+    state.cells = size_t(whole_width) * 8 + size_t(part_width);
+    if (get_value<details::ProgressBarOption::show_percentage>())
+      state.percentage = (std::min)(static_cast<size_t>(progress_ * 100.0), size_t(100));
+    if (get_value<details::ProgressBarOption::show_elapsed_time>() && saved_start_time)
+      state.elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+    if (get_value<details::ProgressBarOption::show_remaining_time>() && saved_start_time)
+      state.remaining_seconds =
+          std::chrono::duration_cast<std::chrono::seconds>(remaining_time(elapsed)).count();
+    state.settings_version = settings_version_;
+    state.completed = get_value<details::ProgressBarOption::completed>() ||
+                      tick_ > get_value<details::ProgressBarOption::max_progress>();
+    return state;
+  }
+
+  // Whether the line last drawn for MultiProgress no longer shows the current
+  // state, so that it only redraws the bars that changed
+  bool changed_since_drawn() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    progress_ = static_cast<float>(tick_) / get_value<details::ProgressBarOption::max_progress>();
+    return visible_state(elapsed_time()) != last_state_;
+  }
+
+  // Appends the prefix text to frame_ and returns its display width
+  int write_prefix_text() {
+    const auto &prefix_text = get_value<details::ProgressBarOption::prefix_text>();
+    frame_ << prefix_text;
+    return text_widths_.prefix.get(prefix_text);
+  }
+
+  // Appends the postfix text to frame_ and returns its display width
+  int write_postfix_text(std::chrono::nanoseconds elapsed) {
+    auto &os = frame_;
+    const auto begin = os.size();
 
     if (get_value<details::ProgressBarOption::show_percentage>()) {
-      os << " " << (std::min)(static_cast<size_t>(progress_ * 100.0), size_t(100))
-         << "%";
+      os << ' ';
+      details::write_percentage(os, (std::min)(progress_ * 100.0, 100.0));
     }
 
     auto &saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
@@ -201,12 +296,7 @@ private:
         os << " [";
 
       if (saved_start_time) {
-        auto eta = std::chrono::nanoseconds(
-            tick_ > 0
-                ? static_cast<long long>(std::ceil(float(elapsed.count()) / progress_))
-                : 0);
-        auto remaining = eta > elapsed ? (eta - elapsed) : (elapsed - eta);
-        details::write_duration(os, remaining);
+        details::write_duration(os, remaining_time(elapsed));
       } else {
         os << "00:00s";
       }
@@ -217,17 +307,20 @@ private:
         os << "]";
     }
 
-    os << " " << get_value<details::ProgressBarOption::postfix_text>();
+    os << ' ';
 
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+    // Everything written so far is ASCII, one column per byte
+    const auto &postfix_text = get_value<details::ProgressBarOption::postfix_text>();
+    const auto postfix_width = text_widths_.postfix.get(postfix_text);
+    const int result_size = postfix_width == -1 ? -1 : int(os.size() - begin) + postfix_width;
+    os << postfix_text;
+    return result_size;
   }
 
-public:
-  void print_progress(bool from_multi_progress = false) {
-    std::lock_guard<std::mutex> lock{mutex_};
-
+  // Skips the frame if_changed and it would look the same as the last one.
+  // Updates skip it; MultiProgress, which has moved the cursor onto this
+  // line, and explicit calls to print_progress() always draw.
+  void draw_progress(bool from_multi_progress, bool if_changed = false) {
     auto &os = get_value<details::ProgressBarOption::stream>();
 
     const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
@@ -238,53 +331,97 @@ public:
       return;
     }
 
-    if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
-      details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
+    // Set before the bar is drawn, so that the bar and the percentage show
+    // the same tick
+    progress_ = static_cast<float>(tick_) / max_progress;
+    const auto elapsed = elapsed_time();
 
-    for (auto &style : get_value<details::ProgressBarOption::font_styles>())
-      details::set_font_style(os, style);
+    const auto state = visible_state(elapsed);
+    if (if_changed && state == last_state_)
+      return;
+    last_state_ = state;
 
-    const auto prefix_pair = get_prefix_text();
-    const auto prefix_text = prefix_pair.first;
-    const auto prefix_length = prefix_pair.second;
-    os << "\r" << prefix_text;
+    frame_.clear();
+    if (style_stale_) {
+      style_.assign(get_value<details::ProgressBarOption::foreground_color>(),
+                    get_value<details::ProgressBarOption::font_styles>());
+      style_stale_ = false;
+    }
+    style_.write(frame_, os);
+    frame_ << '\r';
+    const auto prefix_length = write_prefix_text();
 
-    os << get_value<details::ProgressBarOption::start>();
+    frame_ << get_value<details::ProgressBarOption::start>();
 
-    details::BlockProgressScaleWriter writer{os,
+    details::BlockProgressScaleWriter writer{frame_,
                                              get_value<details::ProgressBarOption::bar_width>()};
     writer.write(progress_ * 100);
 
-    os << get_value<details::ProgressBarOption::end>();
+    frame_ << get_value<details::ProgressBarOption::end>();
 
-    const auto postfix_pair = get_postfix_text();
-    const auto postfix_text = postfix_pair.first;
-    const auto postfix_length = postfix_pair.second;
-    os << postfix_text;
+    const auto postfix_length = write_postfix_text(elapsed);
 
     // Get length of prefix text and postfix text
-    const auto start_length = get_value<details::ProgressBarOption::start>().size();
+    const auto start_length =
+        text_widths_.start.get(get_value<details::ProgressBarOption::start>());
     const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
-    const auto end_length = get_value<details::ProgressBarOption::end>().size();
-    const auto terminal_width = terminal_size().second;
-    // prefix + bar_width + postfix should be <= terminal_width
-    const int remaining = terminal_width - (prefix_length + start_length + bar_width + end_length + postfix_length);
-    if (prefix_length == -1 || postfix_length == -1) {
-      os << "\r";
+    const auto end_length = text_widths_.end.get(get_value<details::ProgressBarOption::end>());
+    const auto terminal_width = terminal_size(os).second;
+    // prefix + bar_width + postfix should be <= terminal_width; a stream that
+    // is not a terminal has no line to pad
+    const int remaining =
+        terminal_width > 0
+            ? int(terminal_width) - int(prefix_length + start_length + bar_width + end_length +
+                                        postfix_length)
+            : 0;
+    if (prefix_length == -1 || postfix_length == -1 || start_length == -1 ||
+        end_length == -1) {
+      frame_ << '\r';
     } else if (remaining > 0) {
-      os << std::string(remaining, ' ') << "\r";
+      frame_.append(remaining, ' ') << '\r';
     } else if (remaining < 0) {
       // Do nothing. Maybe in the future truncate postfix with ...
     }
-    os.flush();
+    throttle_.redrawn();
 
     if (tick_ > max_progress) {
       get_value<details::ProgressBarOption::completed>() = true;
     }
-    if (get_value<details::ProgressBarOption::completed>() &&
-        !from_multi_progress) // Don't std::endl if calling from MultiProgress
+    // MultiProgress and DynamicProgress write frame_ along with the lines of
+    // their other bars, and end the lines themselves
+    if (from_multi_progress)
+      return;
+    frame_.write_to(os);
+    os.flush();
+    if (get_value<details::ProgressBarOption::completed>())
       os << termcolor::reset << std::endl;
   }
+
+  // Draws a frame for an update, unless it would look the same as the last
+  // one
+  void print_progress_if_changed() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(false, true);
+  }
+
+  // Draws this bar's line into frame without writing it, for MultiProgress
+  // and DynamicProgress, which write the lines of all their bars at once
+  void append_line(details::FrameBuffer &frame) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(true);
+    frame.append(frame_.data(), frame_.size());
+  }
+
+public:
+  void print_progress(bool from_multi_progress = false) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(from_multi_progress);
+    if (from_multi_progress) {
+      auto &os = get_value<details::ProgressBarOption::stream>();
+      frame_.write_to(os);
+      os.flush();
+    }
+  }
 };
 
 } // namespace indicators
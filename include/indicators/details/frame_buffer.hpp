@@ -0,0 +1,59 @@
+
+#ifndef INDICATORS_FRAME_BUFFER
+#define INDICATORS_FRAME_BUFFER
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace indicators {
+namespace details {
+
+// The text of one frame, assembled in memory and handed to the stream with a
+// single write(). The storage is kept between frames, so once it has grown to
+// the length of a line, drawing a frame no longer allocates.
+class FrameBuffer {
+public:
+  void clear() { buffer_.clear(); }
+
+  const char *data() const { return buffer_.data(); }
+  size_t size() const { return buffer_.size(); }
+
+  FrameBuffer &append(const char *text, size_t length) {
+    buffer_.append(text, length);
+    return *this;
+  }
+
+  FrameBuffer &append(size_t count, char c) {
+    buffer_.append(count, c);
+    return *this;
+  }
+
+  FrameBuffer &operator<<(const std::string &text) {
+    buffer_.append(text);
+    return *this;
+  }
+
+  FrameBuffer &operator<<(const char *text) {
+    buffer_.append(text, std::strlen(text));
+    return *this;
+  }
+
+  FrameBuffer &operator<<(char c) {
+    buffer_.push_back(c);
+    return *this;
+  }
+
+  void write_to(std::ostream &os) const {
+    os.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  }
+
+private:
+  std::string buffer_;
+};
+
+} // namespace details
+} // namespace indicators
+
+#endif
@@ -0,0 +1,154 @@
+
+#ifndef INDICATORS_NUMBER_FORMAT
+#define INDICATORS_NUMBER_FORMAT
+
+#include <indicators/details/frame_buffer.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace indicators {
+namespace details {
+
+// Formats numbers straight into a FrameBuffer, two digits at a time, without
+// going through iostreams or touching the heap.
+
+inline const char *digit_pairs() {
+  static constexpr char pairs[] = "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899";
+  return pairs;
+}
+
+// Writes the decimal digits of value into the 20 characters that precede end,
+// right-aligned, and returns a pointer to the first digit
+inline char *format_unsigned(unsigned long long value, char *end) {
+  const char *pairs = digit_pairs();
+  char *first = end;
+  while (value >= 100) {
+    first -= 2;
+    std::memcpy(first, pairs + (value % 100) * 2, 2);
+    value /= 100;
+  }
+  if (value >= 10) {
+    first -= 2;
+    std::memcpy(first, pairs + value * 2, 2);
+  } else {
+    *--first = char('0' + value);
+  }
+  return first;
+}
+
+// Writes value in decimal, left-padded with zeros to at least min_digits
+inline FrameBuffer &write_unsigned(FrameBuffer &os, unsigned long long value,
+                                   size_t min_digits = 1) {
+  char digits[20];
+  const char *first = format_unsigned(value, digits + sizeof(digits));
+  const size_t count = size_t(digits + sizeof(digits) - first);
+  if (count < min_digits)
+    os.append(min_digits - count, '0');
+  return os.append(first, count);
+}
+
+// Writes value in decimal with separator between groups of three digits,
+// e.g. 1,234,567
+inline FrameBuffer &write_count(FrameBuffer &os, unsigned long long value, char separator = ',') {
+  char digits[20];
+  const char *first = format_unsigned(value, digits + sizeof(digits));
+  const char *last = digits + sizeof(digits);
+  char grouped[26];
+  char *out = grouped;
+  size_t group = size_t(last - first) % 3 == 0 ? 3 : size_t(last - first) % 3;
+  for (;;) {
+    std::memcpy(out, first, group);
+    out += group;
+    first += group;
+    if (first == last)
+      break;
+    *out++ = separator;
+    group = 3;
+  }
+  return os.append(grouped, size_t(out - grouped));
+}
+
+inline unsigned long long power_of_ten(unsigned exponent) {
+  static constexpr unsigned long long powers[] = {1ull,        10ull,        100ull,
+                                                  1000ull,     10000ull,     100000ull,
+                                                  1000000ull,  10000000ull,  100000000ull,
+                                                  1000000000ull};
+  return powers[exponent];
+}
+
+// Writes value with exactly decimals (at most 9) digits after the point. With
+// truncate, the digits beyond are dropped instead of rounded, so that 99.96
+// with one decimal reads 99.9 rather than 100.0.
+inline FrameBuffer &write_fixed(FrameBuffer &os, double value, unsigned decimals,
+                                bool truncate = false) {
+  if (std::isnan(value))
+    return os << "nan";
+  if (value < 0) {
+    os << '-';
+    value = -value;
+  }
+  if (decimals > 9)
+    decimals = 9;
+  const auto scale = power_of_ten(decimals);
+  const double scaled = truncate ? std::floor(value * scale) : std::floor(value * scale + 0.5);
+  if (!(scaled < 1e19))
+    return os << "inf";
+  const auto units = static_cast<unsigned long long>(scaled);
+  write_unsigned(os, units / scale);
+  if (decimals > 0) {
+    os << '.';
+    write_unsigned(os, units % scale, decimals);
+  }
+  return os;
+}
+
+// Writes a percentage such as 42% or 42.5%. Digits beyond decimals are
+// truncated, so an unfinished task never reads 100%.
+inline FrameBuffer &write_percentage(FrameBuffer &os, double percentage, unsigned decimals = 0) {
+  return write_fixed(os, percentage, decimals, true) << '%';
+}
+
+// Writes a rate such as 1234.5/s
+inline FrameBuffer &write_rate(FrameBuffer &os, double per_second, unsigned decimals = 1) {
+  return write_fixed(os, per_second, decimals) << "/s";
+}
+
+// Writes a duration as [dd"d:"][hh"h:"]mm"m:"ss"s", leaving out the days and
+// hours while they are zero
+inline FrameBuffer &write_duration(FrameBuffer &os, std::chrono::nanoseconds ns) {
+  using namespace std::chrono;
+  if (ns.count() < 0)
+    ns = nanoseconds::zero();
+  using days = duration<int, std::ratio<86400>>;
+  auto d = duration_cast<days>(ns);
+  ns -= d;
+  auto h = duration_cast<hours>(ns);
+  ns -= h;
+  auto m = duration_cast<minutes>(ns);
+  ns -= m;
+  auto s = duration_cast<seconds>(ns);
+  if (d.count() > 0)
+    write_unsigned(os, static_cast<unsigned long long>(d.count()), 2) << "d:";
+  if (h.count() > 0)
+    write_unsigned(os, static_cast<unsigned long long>(h.count()), 2) << "h:";
+  write_unsigned(os, static_cast<unsigned long long>(m.count()), 2) << "m:";
+  write_unsigned(os, static_cast<unsigned long long>(s.count()), 2) << 's';
+  return os;
+}
+
+} // namespace details
+} // namespace indicators
+
+#endif
@@ -0,0 +1,61 @@
+
+#ifndef INDICATORS_REDRAW_THROTTLE
+#define INDICATORS_REDRAW_THROTTLE
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace indicators {
+namespace details {
+
+// Remembers when an indicator last drew a frame, so that frames arriving
+// faster than option::MinRedrawInterval can be skipped. is_due() may be called
+// from any thread without holding the indicator's mutex.
+class RedrawThrottle {
+public:
+  bool is_due(std::chrono::nanoseconds min_interval) const {
+    if (min_interval.count() <= 0)
+      return true;
+    const auto last = last_redraw_.load(std::memory_order_relaxed);
+    return last == never || now() - last >= min_interval.count();
+  }
+
+  void redrawn() { last_redraw_.store(now(), std::memory_order_relaxed); }
+
+private:
+  static constexpr long long never = -1;
+
+  static long long now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  std::atomic<long long> last_redraw_{never};
+};
+
+// The handful of numbers that decide what a frame looks like. Most ticks of a
+// long run leave all of them unchanged, and such a frame need not be drawn.
+struct VisibleState {
+  size_t cells{0};
+  size_t percentage{0};
+  long long elapsed_seconds{0};
+  long long remaining_seconds{0};
+  size_t settings_version{0};
+  bool completed{false};
+};
+
+inline bool operator==(const VisibleState &lhs, const VisibleState &rhs) {
+  return lhs.cells == rhs.cells && lhs.percentage == rhs.percentage &&
+         lhs.elapsed_seconds == rhs.elapsed_seconds &&
+         lhs.remaining_seconds == rhs.remaining_seconds &&
+         lhs.settings_version == rhs.settings_version && lhs.completed == rhs.completed;
+}
+
+inline bool operator!=(const VisibleState &lhs, const VisibleState &rhs) { return !(lhs == rhs); }
+
+} // namespace details
+} // namespace indicators
+
+#endif
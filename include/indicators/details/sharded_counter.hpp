@@ -0,0 +1,128 @@
+
+#ifndef INDICATORS_SHARDED_COUNTER
+#define INDICATORS_SHARDED_COUNTER
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace indicators {
+namespace details {
+
+// A signed counter split into cache-line sized slots. Each thread adds into
+// its own slot, so many cores can count concurrently without bouncing a
+// shared cache line between them. A slot moves its count into the shared
+// total once it holds a batch either way, so the shared line is only written
+// once per batch and the total is always known to within spread() of
+// flushed() without reading the slots. Reading the exact value sums all
+// slots, which is left to the renderer and to updates that may have reached
+// the end.
+class ShardedCounter {
+public:
+  static constexpr long long batch = 64;
+
+  ShardedCounter() : slot_count_(round_up_to_power_of_two(std::thread::hardware_concurrency())),
+                     slots_(new Slot[slot_count_]) {}
+
+  void add(long long n) {
+    auto &slot = slots_[thread_index() & (slot_count_ - 1)].value;
+    const long long value = slot.fetch_add(n) + n;
+    if (value >= batch || value <= -batch)
+      flushed_.value.fetch_add(slot.exchange(0));
+  }
+
+  // The part of the count that has left the slots
+  long long flushed() const { return flushed_.value.load(); }
+
+  // How far sum() can be from flushed(): after each add(), every slot holds
+  // less than a batch either way
+  long long spread() const { return static_cast<long long>(slot_count_) * (batch - 1); }
+
+  long long sum() const {
+    long long result = flushed_.value.load();
+    for (size_t i = 0; i < slot_count_; ++i)
+      result += slots_[i].value.load();
+    return result;
+  }
+
+  // Ticks that race with reset() either happen before it and are cleared,
+  // or after it and are kept. A count that a slot is moving into the total
+  // when reset() runs lands in the total afterwards, so it is kept too.
+  void reset() {
+    for (size_t i = 0; i < slot_count_; ++i)
+      slots_[i].value.store(0);
+    flushed_.value.store(0);
+  }
+
+private:
+  static constexpr size_t cache_line_size = 64;
+
+  // Padded so that consecutive slots never share a cache line, whatever the
+  // alignment of the array itself
+  struct Slot {
+    std::atomic<long long> value{0};
+    char padding[cache_line_size - sizeof(std::atomic<long long>)];
+  };
+
+  static size_t round_up_to_power_of_two(size_t n) {
+    size_t result = 1;
+    while (result < n)
+      result <<= 1;
+    return result;
+  }
+
+  // The lowest number that no live thread holds, taken by a thread the first
+  // time it touches any ShardedCounter and given back when it exits. Up to
+  // hardware_concurrency() live threads get a slot of their own, however
+  // often a thread pool replaces its threads.
+  class ThreadIndex {
+  public:
+    ThreadIndex() {
+      std::lock_guard<std::mutex> lock{mutex()};
+      auto &taken = indices();
+      value = static_cast<size_t>(std::find(taken.begin(), taken.end(), false) - taken.begin());
+      if (value == taken.size())
+        taken.push_back(true);
+      else
+        taken[value] = true;
+    }
+
+    ~ThreadIndex() {
+      std::lock_guard<std::mutex> lock{mutex()};
+      indices()[value] = false;
+    }
+
+    size_t value;
+
+  private:
+    static std::mutex &mutex() {
+      static std::mutex result;
+      return result;
+    }
+
+    static std::vector<bool> &indices() {
+      static std::vector<bool> result;
+      return result;
+    }
+  };
+
+  static size_t thread_index() {
+    thread_local ThreadIndex index;
+    return index.value;
+  }
+
+  // Padded like a slot, so that writing it does not evict the members below,
+  // which every add() reads
+  Slot flushed_;
+  size_t slot_count_;
+  std::unique_ptr<Slot[]> slots_;
+};
+
+} // namespace details
+} // namespace indicators
+
+#endif
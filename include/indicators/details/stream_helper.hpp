@@ -2,6 +2,8 @@
 #ifndef INDICATORS_STREAM_HELPER
 #define INDICATORS_STREAM_HELPER
 
+#include <indicators/details/frame_buffer.hpp>
+#include <indicators/details/number_format.hpp>
 #include <indicators/display_width.hpp>
 #include <indicators/setting.hpp>
 #include <indicators/termcolor.hpp>
@@ -16,6 +18,14 @@
 #include <cassert>
 #include <cmath>
 
+// termcolor undefines the implementation it autodetected at the end of its
+// header, so its choice is repeated here
+#if defined(TERMCOLOR_USE_ANSI_ESCAPE_SEQUENCES) ||                                          \
+    (!defined(TERMCOLOR_USE_WINDOWS_API) && !defined(TERMCOLOR_USE_NOOP) && !defined(_WIN32) && \
+     !defined(_WIN64))
+#define INDICATORS_ANSI_ESCAPE_SEQUENCES
+#endif
+
 namespace indicators {
 namespace details {
 
@@ -81,6 +91,76 @@ inline void set_font_style(std::ostream &os, FontStyle style) {
   }
 }
 
+// An indicator's foreground colour and font styles merged into a single SGR
+// escape sequence such as "\033[33;1m". It is built when those options change
+// and copied into each frame only if the stream is colourised. Consoles driven
+// through the Windows API cannot take escape sequences, so there the
+// termcolor manipulators are still applied to the stream.
+class StylePrefix {
+public:
+  static constexpr bool depends_on(ProgressBarOption id) {
+    return id == ProgressBarOption::foreground_color || id == ProgressBarOption::font_styles;
+  }
+
+  void assign(Color color, const std::vector<FontStyle> &styles) {
+    color_ = color;
+    styles_ = styles;
+    sgr_.clear();
+    if (color != Color::unspecified)
+      add_parameter(30 + static_cast<int>(color));
+    for (auto style : styles)
+      add_parameter(sgr_parameter(style));
+    if (!sgr_.empty())
+      sgr_ = "\033[" + sgr_ + "m";
+  }
+
+  void write(FrameBuffer &frame, std::ostream &os) const {
+#if defined(INDICATORS_ANSI_ESCAPE_SEQUENCES)
+    if (!sgr_.empty() && termcolor::_internal::is_colorized(os))
+      frame << sgr_;
+#else
+    (void)frame;
+    if (color_ != Color::unspecified)
+      set_stream_color(os, color_);
+    for (auto style : styles_)
+      set_font_style(os, style);
+#endif
+  }
+
+private:
+  static int sgr_parameter(FontStyle style) {
+    switch (style) {
+    case FontStyle::bold:
+      return 1;
+    case FontStyle::dark:
+      return 2;
+    case FontStyle::italic:
+      return 3;
+    case FontStyle::underline:
+      return 4;
+    case FontStyle::blink:
+      return 5;
+    case FontStyle::reverse:
+      return 7;
+    case FontStyle::concealed:
+      return 8;
+    case FontStyle::crossed:
+      return 9;
+    }
+    return 0;
+  }
+
+  void add_parameter(int parameter) {
+    if (!sgr_.empty())
+      sgr_ += ';';
+    sgr_ += std::to_string(parameter);
+  }
+
+  Color color_ = Color::unspecified;
+  std::vector<FontStyle> styles_;
+  std::string sgr_;
+};
+
 inline std::ostream &write_duration(std::ostream &os, std::chrono::nanoseconds ns) {
   using namespace std;
   using namespace std::chrono;
@@ -105,116 +185,138 @@ inline std::ostream &write_duration(std::ostream &os, std::chrono::nanoseconds n
 
 class BlockProgressScaleWriter {
 public:
-  BlockProgressScaleWriter(std::ostream &os, size_t bar_width) : os(os), bar_width(bar_width) {}
+  BlockProgressScaleWriter(FrameBuffer &os, size_t bar_width) : os(os), bar_width(bar_width) {}
+
+  FrameBuffer &write(float progress) {
+    // A run of full blocks that is sliced to length, and the partial blocks
+    // for each eighth of a cell
+    static constexpr const char fill_run[] =
+        "████████████████"
+        "████████████████"
+        "████████████████"
+        "████████████████";
+    static constexpr size_t fill_bytes = 3;
+    static constexpr size_t fill_run_cells = (sizeof(fill_run) - 1) / fill_bytes;
+    static constexpr const char *lead_characters[] = {" ", "▏", "▎", "▍", "▌", "▋", "▊", "▉"};
 
-  std::ostream &write(float progress) {
-    std::string fill_text{"█"};
-    std::vector<std::string> lead_characters{" ", "▏", "▎", "▍", "▌", "▋", "▊", "▉"};
     auto value = (std::min)(1.0f, (std::max)(0.0f, progress / 100.0f));
-    auto whole_width = std::floor(value * bar_width);
+    auto whole_width = size_t(std::floor(value * bar_width));
     auto remainder_width = fmod((value * bar_width), 1.0f);
-    auto part_width = std::floor(remainder_width * lead_characters.size());
-    std::string lead_text = lead_characters[size_t(part_width)];
-    if ((bar_width - whole_width - 1) < 0)
-      lead_text = "";
-    for (size_t i = 0; i < whole_width; ++i)
-      os << fill_text;
-    os << lead_text;
-    for (size_t i = 0; i < (bar_width - whole_width - 1); ++i)
-      os << " ";
+    auto part_width = size_t(std::floor(remainder_width * 8));
+    for (size_t cells = whole_width; cells > 0;) {
+      const auto slice = (std::min)(cells, fill_run_cells);
+      os.append(fill_run, slice * fill_bytes);
+      cells -= slice;
+    }
+    if (whole_width < bar_width) {
+      os << lead_characters[part_width];
+      os.append(bar_width - whole_width - 1, ' ');
+    }
     return os;
   }
 
 private:
-  std::ostream &os;
+  FrameBuffer &os;
   size_t bar_width = 0;
 };
 
-class ProgressScaleWriter {
+// One glyph of a bar, repeated as often as it fits in the bar, so that any
+// number of copies can be written with a single append.
+struct GlyphRun {
+  std::string text;
+  size_t bytes = 0;
+  size_t width = 1;
+
+  void assign(const std::string &glyph, size_t bar_width) {
+    // Glyphs without a usable width (empty, combining or control characters)
+    // take up one cell, otherwise the bar would never fill
+    const auto glyph_width = unicode::display_width(glyph);
+    width = glyph_width > 0 ? size_t(glyph_width) : 1;
+    bytes = glyph.size();
+    text.clear();
+    for (size_t i = 0; i < bar_width / width; ++i)
+      text += glyph;
+  }
+
+  void write(FrameBuffer &os, size_t count) const { os.append(text.data(), bytes * count); }
+};
+
+// The glyphs of a bar and their display widths, measured once when the
+// indicator's BarWidth, Fill, Lead or Remainder change rather than on every
+// frame.
+class ProgressScale {
 public:
-  ProgressScaleWriter(std::ostream &os, size_t bar_width, const std::string &fill,
-                      const std::string &lead, const std::string &remainder)
-      : os(os), bar_width(bar_width), fill(fill), lead(lead), remainder(remainder) {}
-
-  std::ostream &write(float progress) {
-    auto pos = static_cast<size_t>(progress * bar_width / 100.0);
-    for (size_t i = 0, current_display_width = 0; i < bar_width;) {
-      std::string next;
-
-      if (i < pos) {
-        next = fill;
-        current_display_width = unicode::display_width(fill);
-      } else if (i == pos) {
-        next = lead;
-        current_display_width = unicode::display_width(lead);
-      } else {
-        next = remainder;
-        current_display_width = unicode::display_width(remainder);
-      }
-
-      i += current_display_width;
-
-      if (i > bar_width) {
-        // `next` is larger than the allowed bar width
-        // fill with empty space instead
-        os << std::string((bar_width - (i - current_display_width)), ' ');
-        break;
-      }
-
-      os << next;
+  static constexpr bool depends_on(ProgressBarOption id) {
+    return id == ProgressBarOption::bar_width || id == ProgressBarOption::fill ||
+           id == ProgressBarOption::lead || id == ProgressBarOption::remainder;
+  }
+
+  void assign(size_t bar_width, const std::string &fill, const std::string &lead,
+              const std::string &remainder) {
+    bar_width_ = bar_width;
+    fill_.assign(fill, bar_width);
+    lead_.assign(lead, bar_width);
+    remainder_.assign(remainder, bar_width);
+  }
+
+  size_t bar_width() const { return bar_width_; }
+
+  // Fills the cells before pos, puts the lead at pos and the remainder after
+  // it. A glyph that would overflow the bar is replaced by spaces.
+  FrameBuffer &write(FrameBuffer &os, size_t pos) const {
+    const auto fills = (std::min)((pos + fill_.width - 1) / fill_.width, bar_width_ / fill_.width);
+    fill_.write(os, fills);
+    auto i = fills * fill_.width;
+    if (i >= bar_width_)
+      return os;
+    if (i < pos)
+      return os.append(bar_width_ - i, ' ');
+
+    if (i == pos) {
+      if (i + lead_.width > bar_width_)
+        return os.append(bar_width_ - i, ' ');
+      lead_.write(os, 1);
+      i += lead_.width;
     }
-    return os;
+
+    const auto remainders = (bar_width_ - i) / remainder_.width;
+    remainder_.write(os, remainders);
+    i += remainders * remainder_.width;
+    return os.append(bar_width_ - i, ' ');
   }
 
 private:
-  std::ostream &os;
-  size_t bar_width = 0;
-  std::string fill;
-  std::string lead;
-  std::string remainder;
+  size_t bar_width_ = 0;
+  GlyphRun fill_;
+  GlyphRun lead_;
+  GlyphRun remainder_;
 };
 
-class IndeterminateProgressScaleWriter {
+class ProgressScaleWriter {
 public:
-  IndeterminateProgressScaleWriter(std::ostream &os, size_t bar_width, const std::string &fill,
-                                   const std::string &lead)
-      : os(os), bar_width(bar_width), fill(fill), lead(lead) {}
-
-  std::ostream &write(size_t progress) {
-    for (size_t i = 0; i < bar_width;) {
-      std::string next;
-      size_t current_display_width = 0;
-
-      if (i < progress) {
-        next = fill;
-        current_display_width = unicode::display_width(fill);
-      } else if (i == progress) {
-        next = lead;
-        current_display_width = unicode::display_width(lead);
-      } else {
-        next = fill;
-        current_display_width = unicode::display_width(fill);
-      }
-
-      i += current_display_width;
-
-      if (i > bar_width) {
-        // `next` is larger than the allowed bar width
-        // fill with empty space instead
-        os << std::string((bar_width - (i - current_display_width)), ' ');
-        break;
-      }
-
-      os << next;
-    }
-    return os;
+  ProgressScaleWriter(FrameBuffer &os, const ProgressScale &scale) : os(os), scale(scale) {}
+
+  FrameBuffer &write(float progress) {
+    return scale.write(os, static_cast<size_t>(progress * scale.bar_width() / 100.0));
   }
 
 private:
-  std::ostream &os;
-  size_t bar_width = 0;
-  std::string fill;
-  std::string lead;
+  FrameBuffer &os;
+  const ProgressScale &scale;
+};
+
+// Draws a scale assigned with the fill as its remainder, so that the lead
+// moves over an otherwise filled bar
+class IndeterminateProgressScaleWriter {
+public:
+  IndeterminateProgressScaleWriter(FrameBuffer &os, const ProgressScale &scale)
+      : os(os), scale(scale) {}
+
+  FrameBuffer &write(size_t progress) { return scale.write(os, progress); }
+
+private:
+  FrameBuffer &os;
+  const ProgressScale &scale;
 };
 
 } // namespace details
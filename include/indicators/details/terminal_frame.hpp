@@ -0,0 +1,126 @@
+
+#ifndef INDICATORS_TERMINAL_FRAME
+#define INDICATORS_TERMINAL_FRAME
+
+#include <indicators/cursor_control.hpp>
+#include <indicators/cursor_movement.hpp>
+#include <indicators/details/frame_buffer.hpp>
+#include <indicators/details/number_format.hpp>
+#include <indicators/details/stream_helper.hpp>
+#include <indicators/termcolor.hpp>
+
+#include <cstddef>
+#include <ostream>
+
+namespace indicators {
+namespace details {
+
+// A frame of MultiProgress or DynamicProgress: the cursor movements and the
+// lines of all bars, assembled in one buffer and handed to the stream with a
+// single write(), so that the terminal never shows half a frame. On a
+// terminal, the frame is also wrapped in the synchronized update mode (DEC
+// private mode 2026), which tells terminals that support it to draw the
+// frame only once it is complete; others ignore the unknown mode.
+//
+// On Windows consoles without escape sequences, cursor movements and colours
+// are console calls rather than text, so the buffer is written out before
+// each of them to keep everything in order.
+class TerminalFrame {
+public:
+  void begin(std::ostream &os) {
+    if (os_ != &os) {
+      os_ = &os;
+#if defined(INDICATORS_ANSI_ESCAPE_SEQUENCES) && !defined(_MSC_VER)
+      synchronized_ = termcolor::_internal::is_atty(os);
+#endif
+    }
+    buffer_.clear();
+    if (synchronized_)
+      buffer_ << "\033[?2026h";
+    empty_ = true;
+  }
+
+  void move_up(size_t lines) {
+    if (lines == 0)
+      return;
+    empty_ = false;
+#if defined(_MSC_VER)
+    flush();
+    indicators::move_up(static_cast<int>(lines));
+#else
+    write_unsigned(buffer_ << "\033[", lines) << 'A';
+#endif
+  }
+
+  void move_down(size_t lines) {
+    if (lines == 0)
+      return;
+    empty_ = false;
+#if defined(_MSC_VER)
+    flush();
+    indicators::move_down(static_cast<int>(lines));
+#else
+    write_unsigned(buffer_ << "\033[", lines) << 'B';
+#endif
+  }
+
+  void erase_line() {
+    empty_ = false;
+#if defined(_MSC_VER)
+    flush();
+    indicators::erase_line();
+#else
+    buffer_ << "\r\033[K";
+#endif
+  }
+
+  // The buffer that the next line is drawn into
+  FrameBuffer &begin_line() {
+    empty_ = false;
+#if !defined(INDICATORS_ANSI_ESCAPE_SEQUENCES)
+    // The bar sets its colour on the stream as it draws the line
+    flush();
+#endif
+    return buffer_;
+  }
+
+  void end_line() {
+    buffer_ << '\n';
+#if !defined(INDICATORS_ANSI_ESCAPE_SEQUENCES)
+    flush();
+#endif
+  }
+
+  // Resets the colour and writes the frame, unless nothing was drawn
+  void end() {
+    if (empty_)
+      return;
+#if defined(INDICATORS_ANSI_ESCAPE_SEQUENCES)
+    if (termcolor::_internal::is_colorized(*os_))
+      buffer_ << "\033[00m";
+#else
+    flush();
+    *os_ << termcolor::reset;
+#endif
+    if (synchronized_)
+      buffer_ << "\033[?2026l";
+    flush();
+    os_->flush();
+  }
+
+private:
+  void flush() {
+    buffer_.write_to(*os_);
+    buffer_.clear();
+  }
+
+  std::ostream *os_{nullptr};
+  FrameBuffer buffer_;
+  bool synchronized_{false};
+  bool empty_{true};
+};
+
+} // namespace details
+} // namespace indicators
+
+#endif
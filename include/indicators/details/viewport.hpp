@@ -0,0 +1,150 @@
+
+#ifndef INDICATORS_VIEWPORT
+#define INDICATORS_VIEWPORT
+
+#include <indicators/details/frame_buffer.hpp>
+#include <indicators/details/number_format.hpp>
+#include <indicators/terminal_size.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace indicators {
+namespace details {
+
+// Picks which of many bars, identified by index, get the rows of a terminal
+// too short to show them all, for MultiProgress and DynamicProgress. Running
+// bars that were updated most recently get rows first, then bars that have
+// never been on screen, found by a cursor that only moves forward. A
+// completed bar keeps its row until another bar needs it, unless completed
+// bars are hidden. layout() only looks at the bars on screen and the bars
+// touched since the last layout, so its cost follows the height of the
+// terminal, not the number of bars. Callers serialise all calls.
+class Viewport {
+public:
+  // The lines available above the cursor, which rests on the row below the
+  // last line. A stream that is not a terminal gets the height of a classic
+  // one.
+  static size_t lines(std::ostream &os) {
+    size_t rows = terminal_size(os).first;
+    if (rows == 0)
+      rows = 24;
+    return (std::max)(rows, size_t(2)) - 1;
+  }
+
+  void resize(size_t count) { state_.resize(count); }
+  void push_back() { state_.push_back(0); }
+
+  // Marks bar index as updated since the last layout()
+  void touch(size_t index) {
+    if (state_[index] & touched)
+      return;
+    state_[index] |= touched;
+    touched_.push_back(index);
+  }
+
+  // Fits the bars into lines, keeping one line for the summary when they do
+  // not all fit. is_completed(index) tells whether bar index has completed.
+  template <typename IsCompleted>
+  void layout(size_t lines, bool hide_completed, IsCompleted is_completed) {
+    const size_t capacity = state_.size() <= lines ? lines : lines - 1;
+
+    for (auto index : touched_) {
+      state_[index] &= ~touched;
+      count_if_done(index, is_completed);
+    }
+    while (shown_.size() > capacity) {
+      state_[shown_.back()] &= ~shown;
+      shown_.pop_back();
+    }
+    size_t next;
+    for (auto &index : shown_) {
+      count_if_done(index, is_completed);
+      if (is_completed(index) && next_waiting(next, is_completed)) {
+        state_[index] &= ~shown;
+        state_[next] |= shown;
+        index = next;
+      }
+    }
+    if (hide_completed) {
+      shown_.erase(std::remove_if(shown_.begin(), shown_.end(),
+                                  [this, &is_completed](size_t index) {
+                                    if (!is_completed(index))
+                                      return false;
+                                    state_[index] &= ~shown;
+                                    return true;
+                                  }),
+                   shown_.end());
+    }
+    while (shown_.size() < capacity && next_waiting(next, is_completed)) {
+      state_[next] |= shown;
+      shown_.push_back(next);
+    }
+    touched_.clear();
+
+    size_t shown_done = 0;
+    for (auto index : shown_)
+      shown_done += is_completed(index);
+    hidden_done_ = done_count_ - (std::min)(shown_done, done_count_);
+  }
+
+  // The bar on each row, top to bottom
+  const std::vector<size_t> &rows() const { return shown_; }
+
+  size_t hidden() const { return state_.size() - shown_.size(); }
+  size_t hidden_done() const { return hidden_done_; }
+
+  // The line that stands for the bars off screen
+  void write_summary(FrameBuffer &line) const {
+    write_unsigned(line << '+', hidden()) << " more (";
+    write_unsigned(line, hidden_done_) << " done)";
+  }
+
+private:
+  enum : unsigned char { touched = 1, shown = 2, counted_done = 4 };
+
+  template <typename IsCompleted> void count_if_done(size_t index, IsCompleted &is_completed) {
+    if (!(state_[index] & counted_done) && is_completed(index)) {
+      state_[index] |= counted_done;
+      ++done_count_;
+    }
+  }
+
+  // The bar to put in a free row: the most recently updated bar that is not
+  // on screen and still running, or else the next bar that has never been on
+  // screen
+  template <typename IsCompleted> bool next_waiting(size_t &next, IsCompleted &is_completed) {
+    while (!touched_.empty()) {
+      next = touched_.back();
+      touched_.pop_back();
+      if (!(state_[next] & shown) && !is_completed(next))
+        return true;
+    }
+    for (; next_unseen_ < state_.size(); ++next_unseen_) {
+      next = next_unseen_;
+      count_if_done(next, is_completed);
+      if (!(state_[next] & shown) && !is_completed(next)) {
+        ++next_unseen_;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<unsigned char> state_;
+  // The bars on screen, one per row
+  std::vector<size_t> shown_;
+  // The bars updated since the last layout, most recent last
+  std::vector<size_t> touched_;
+  // The first bar that has never been considered for a row
+  size_t next_unseen_{0};
+  size_t done_count_{0};
+  size_t hidden_done_{0};
+};
+
+} // namespace details
+} // namespace indicators
+
+#endif
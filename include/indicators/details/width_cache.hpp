@@ -0,0 +1,113 @@
+
+#ifndef INDICATORS_WIDTH_CACHE
+#define INDICATORS_WIDTH_CACHE
+
+#include <indicators/display_width.hpp>
+#include <indicators/setting.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace indicators {
+namespace details {
+
+// Process-wide memo of the widths of recently measured texts, for texts that
+// change between frames but keep coming back, such as a postfix that cycles
+// through a few status messages. Each text has one slot, chosen by its hash,
+// and evicts whatever was there, so the cache never holds more than slots
+// texts of at most max_length bytes. Printable ASCII is as wide as it is long
+// and bypasses the cache, and so does a thread that finds the cache locked,
+// so that drawing never waits for it.
+class WidthCache {
+public:
+  static constexpr size_t slots = 64;
+  static constexpr size_t max_length = 256;
+
+  static WidthCache &instance() {
+    static WidthCache cache;
+    return cache;
+  }
+
+  int width(const std::string &text) {
+    const size_t size = text.size();
+    if (unicode::details::printable_ascii_prefix(text.data(), size) == size)
+      return static_cast<int>(size);
+    if (size > max_length)
+      return unicode::display_width(text);
+    const size_t hash = std::hash<std::string>()(text);
+    std::unique_lock<std::mutex> lock{mutex_, std::try_to_lock};
+    if (!lock.owns_lock())
+      return unicode::display_width(text);
+    Entry &entry = entries_[hash % slots];
+    if (entry.hash != hash || entry.text != text) {
+      // Reuses the storage of the text it evicts
+      entry.text.assign(text);
+      entry.hash = hash;
+      entry.width = unicode::display_width(text);
+    }
+    return entry.width;
+  }
+
+private:
+  struct Entry {
+    size_t hash{0};
+    std::string text;
+    int width{0};
+  };
+
+  std::mutex mutex_;
+  Entry entries_[slots];
+};
+
+// The display width of one of an indicator's configured texts, measured when
+// the first frame is drawn and again only after set_option() has changed it
+class CachedWidth {
+public:
+  int get(const std::string &text) {
+    if (stale_) {
+      width_ = WidthCache::instance().width(text);
+      stale_ = false;
+    }
+    return width_;
+  }
+
+  void invalidate() { stale_ = true; }
+
+private:
+  int width_{0};
+  bool stale_{true};
+};
+
+// Widths of the texts that a progress bar draws around its scale
+struct TextWidths {
+  CachedWidth prefix;
+  CachedWidth postfix;
+  CachedWidth start;
+  CachedWidth end;
+
+  void invalidate(ProgressBarOption id) {
+    switch (id) {
+    case ProgressBarOption::prefix_text:
+      prefix.invalidate();
+      break;
+    case ProgressBarOption::postfix_text:
+      postfix.invalidate();
+      break;
+    case ProgressBarOption::start:
+      start.invalidate();
+      break;
+    case ProgressBarOption::end:
+      end.invalidate();
+      break;
+    default:
+      break;
+    }
+  }
+};
+
+} // namespace details
+} // namespace indicators
+
+#endif
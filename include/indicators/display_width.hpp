@@ -2,11 +2,31 @@
 #ifndef INDICATORS_DISPLAY_WIDTH
 #define INDICATORS_DISPLAY_WIDTH
 
-#include <clocale>
-#include <cstdlib>
-#include <locale>
+#include <indicators/details/width_table.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
-#include <wchar.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INDICATORS_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// From C++17 on, the decoding and width rules below are constexpr, so that
+// indicators::literal_width() can measure string literals at compile time
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define INDICATORS_CONSTEXPR_WIDTH constexpr
+#define INDICATORS_HAS_LITERAL_WIDTH
+#else
+#define INDICATORS_CONSTEXPR_WIDTH
+#endif
 
 namespace unicode {
 
@@ -73,31 +93,6 @@ namespace details {
  * Latest version: http://www.cl.cam.ac.uk/~mgk25/ucs/wcwidth.c
  */
 
-struct interval {
-  int first;
-  int last;
-};
-
-/* auxiliary function for binary search in interval table */
-static inline int bisearch(wchar_t ucs, const struct interval *table, int max) {
-  int min = 0;
-  int mid;
-
-  if (ucs < table[0].first || ucs > table[max].last)
-    return 0;
-  while (max >= min) {
-    mid = (min + max) / 2;
-    if (ucs > table[mid].last)
-      min = mid + 1;
-    else if (ucs < table[mid].first)
-      max = mid - 1;
-    else
-      return 1;
-  }
-
-  return 0;
-}
-
 /* The following two functions define the column width of an ISO 10646
  * character as follows:
  *
@@ -115,100 +110,38 @@ static inline int bisearch(wchar_t ucs, const struct interval *table, int max) {
  *    - Other format characters (general category code Cf in the Unicode
  *      database) and ZERO WIDTH SPACE (U+200B) have a column width of 0.
  *
- *    - Hangul Jamo medial vowels and final consonants (U+1160-U+11FF)
- *      have a column width of 0.
+ *    - Hangul Jamo medial vowels and final consonants (U+1160-U+11FF,
+ *      U+D7B0-U+D7FF) have a column width of 0.
  *
  *    - Spacing characters in the East Asian Wide (W) or East Asian
  *      Full-width (F) category as defined in Unicode Technical
- *      Report #11 have a column width of 2.
+ *      Report #11 have a column width of 2. So do regional indicators
+ *      (U+1F1E6-U+1F1FF), which are drawn in pairs as one flag.
  *
  *    - All remaining characters (including all printable
  *      ISO 8859-1 and WGL4 characters, Unicode control characters,
  *      etc.) have a column width of 1.
  *
  * This implementation assumes that wchar_t characters are encoded
- * in ISO 10646.
+ * in ISO 10646. Code points are taken as char32_t, so that characters
+ * beyond the BMP keep their width where wchar_t is 16 bits wide.
+ *
+ * Unlike the original, the categories come from the Unicode release
+ * named at the top of details/width_table.hpp, not from Unicode 5.0.
  */
 
-static inline int mk_wcwidth(wchar_t ucs) {
-  /* sorted list of non-overlapping intervals of non-spacing characters */
-  /* generated by "uniset +cat=Me +cat=Mn +cat=Cf -00AD +1160-11FF +200B c" */
-  static const struct interval combining[] = {
-      {0x0300, 0x036F},   {0x0483, 0x0486},   {0x0488, 0x0489},
-      {0x0591, 0x05BD},   {0x05BF, 0x05BF},   {0x05C1, 0x05C2},
-      {0x05C4, 0x05C5},   {0x05C7, 0x05C7},   {0x0600, 0x0603},
-      {0x0610, 0x0615},   {0x064B, 0x065E},   {0x0670, 0x0670},
-      {0x06D6, 0x06E4},   {0x06E7, 0x06E8},   {0x06EA, 0x06ED},
-      {0x070F, 0x070F},   {0x0711, 0x0711},   {0x0730, 0x074A},
-      {0x07A6, 0x07B0},   {0x07EB, 0x07F3},   {0x0901, 0x0902},
-      {0x093C, 0x093C},   {0x0941, 0x0948},   {0x094D, 0x094D},
-      {0x0951, 0x0954},   {0x0962, 0x0963},   {0x0981, 0x0981},
-      {0x09BC, 0x09BC},   {0x09C1, 0x09C4},   {0x09CD, 0x09CD},
-      {0x09E2, 0x09E3},   {0x0A01, 0x0A02},   {0x0A3C, 0x0A3C},
-      {0x0A41, 0x0A42},   {0x0A47, 0x0A48},   {0x0A4B, 0x0A4D},
-      {0x0A70, 0x0A71},   {0x0A81, 0x0A82},   {0x0ABC, 0x0ABC},
-      {0x0AC1, 0x0AC5},   {0x0AC7, 0x0AC8},   {0x0ACD, 0x0ACD},
-      {0x0AE2, 0x0AE3},   {0x0B01, 0x0B01},   {0x0B3C, 0x0B3C},
-      {0x0B3F, 0x0B3F},   {0x0B41, 0x0B43},   {0x0B4D, 0x0B4D},
-      {0x0B56, 0x0B56},   {0x0B82, 0x0B82},   {0x0BC0, 0x0BC0},
-      {0x0BCD, 0x0BCD},   {0x0C3E, 0x0C40},   {0x0C46, 0x0C48},
-      {0x0C4A, 0x0C4D},   {0x0C55, 0x0C56},   {0x0CBC, 0x0CBC},
-      {0x0CBF, 0x0CBF},   {0x0CC6, 0x0CC6},   {0x0CCC, 0x0CCD},
-      {0x0CE2, 0x0CE3},   {0x0D41, 0x0D43},   {0x0D4D, 0x0D4D},
-      {0x0DCA, 0x0DCA},   {0x0DD2, 0x0DD4},   {0x0DD6, 0x0DD6},
-      {0x0E31, 0x0E31},   {0x0E34, 0x0E3A},   {0x0E47, 0x0E4E},
-      {0x0EB1, 0x0EB1},   {0x0EB4, 0x0EB9},   {0x0EBB, 0x0EBC},
-      {0x0EC8, 0x0ECD},   {0x0F18, 0x0F19},   {0x0F35, 0x0F35},
-      {0x0F37, 0x0F37},   {0x0F39, 0x0F39},   {0x0F71, 0x0F7E},
-      {0x0F80, 0x0F84},   {0x0F86, 0x0F87},   {0x0F90, 0x0F97},
-      {0x0F99, 0x0FBC},   {0x0FC6, 0x0FC6},   {0x102D, 0x1030},
-      {0x1032, 0x1032},   {0x1036, 0x1037},   {0x1039, 0x1039},
-      {0x1058, 0x1059},   {0x1160, 0x11FF},   {0x135F, 0x135F},
-      {0x1712, 0x1714},   {0x1732, 0x1734},   {0x1752, 0x1753},
-      {0x1772, 0x1773},   {0x17B4, 0x17B5},   {0x17B7, 0x17BD},
-      {0x17C6, 0x17C6},   {0x17C9, 0x17D3},   {0x17DD, 0x17DD},
-      {0x180B, 0x180D},   {0x18A9, 0x18A9},   {0x1920, 0x1922},
-      {0x1927, 0x1928},   {0x1932, 0x1932},   {0x1939, 0x193B},
-      {0x1A17, 0x1A18},   {0x1B00, 0x1B03},   {0x1B34, 0x1B34},
-      {0x1B36, 0x1B3A},   {0x1B3C, 0x1B3C},   {0x1B42, 0x1B42},
-      {0x1B6B, 0x1B73},   {0x1DC0, 0x1DCA},   {0x1DFE, 0x1DFF},
-      {0x200B, 0x200F},   {0x202A, 0x202E},   {0x2060, 0x2063},
-      {0x206A, 0x206F},   {0x20D0, 0x20EF},   {0x302A, 0x302F},
-      {0x3099, 0x309A},   {0xA806, 0xA806},   {0xA80B, 0xA80B},
-      {0xA825, 0xA826},   {0xFB1E, 0xFB1E},   {0xFE00, 0xFE0F},
-      {0xFE20, 0xFE23},   {0xFEFF, 0xFEFF},   {0xFFF9, 0xFFFB},
-      {0x10A01, 0x10A03}, {0x10A05, 0x10A06}, {0x10A0C, 0x10A0F},
-      {0x10A38, 0x10A3A}, {0x10A3F, 0x10A3F}, {0x1D167, 0x1D169},
-      {0x1D173, 0x1D182}, {0x1D185, 0x1D18B}, {0x1D1AA, 0x1D1AD},
-      {0x1D242, 0x1D244}, {0xE0001, 0xE0001}, {0xE0020, 0xE007F},
-      {0xE0100, 0xE01EF}};
-
+static inline INDICATORS_CONSTEXPR_WIDTH int mk_wcwidth(char32_t ucs) {
   /* test for 8-bit control characters */
   if (ucs == 0)
     return 0;
   if (ucs < 32 || (ucs >= 0x7f && ucs < 0xa0))
     return -1;
 
-  /* binary search in table of non-spacing characters */
-  if (bisearch(ucs, combining, sizeof(combining) / sizeof(struct interval) - 1))
-    return 0;
-
-  /* if we arrive here, ucs is not a combining or C0/C1 control character */
-
-  return 1 +
-         (ucs >= 0x1100 &&
-          (ucs <= 0x115f || /* Hangul Jamo init. consonants */
-           ucs == 0x2329 || ucs == 0x232a ||
-           (ucs >= 0x2e80 && ucs <= 0xa4cf && ucs != 0x303f) || /* CJK ... Yi */
-           (ucs >= 0xac00 && ucs <= 0xd7a3) || /* Hangul Syllables */
-           (ucs >= 0xf900 &&
-            ucs <= 0xfaff) || /* CJK Compatibility Ideographs */
-           (ucs >= 0xfe10 && ucs <= 0xfe19) || /* Vertical forms */
-           (ucs >= 0xfe30 && ucs <= 0xfe6f) || /* CJK Compatibility Forms */
-           (ucs >= 0xff00 && ucs <= 0xff60) || /* Fullwidth Forms */
-           (ucs >= 0xffe0 && ucs <= 0xffe6) ||
-           (ucs >= 0x20000 && ucs <= 0x2fffd) ||
-           (ucs >= 0x30000 && ucs <= 0x3fffd)));
+  /* the widths of all other characters are looked up in the table generated
+   * by utils/width_table/generate_width_table.py, in which ambiguous
+   * characters are narrow */
+  const int width = width_class(ucs);
+  return width == 3 ? 1 : width;
 }
 
 static inline int mk_wcswidth(const wchar_t *pwcs, size_t n) {
@@ -232,68 +165,14 @@ static inline int mk_wcswidth(const wchar_t *pwcs, size_t n) {
  * the traditional terminal character-width behaviour. It is not
  * otherwise recommended for general use.
  */
-static inline int mk_wcwidth_cjk(wchar_t ucs) {
-  /* sorted list of non-overlapping intervals of East Asian Ambiguous
-   * characters, generated by "uniset +WIDTH-A -cat=Me -cat=Mn -cat=Cf c" */
-  static const struct interval ambiguous[] = {
-      {0x00A1, 0x00A1}, {0x00A4, 0x00A4},   {0x00A7, 0x00A8},
-      {0x00AA, 0x00AA}, {0x00AE, 0x00AE},   {0x00B0, 0x00B4},
-      {0x00B6, 0x00BA}, {0x00BC, 0x00BF},   {0x00C6, 0x00C6},
-      {0x00D0, 0x00D0}, {0x00D7, 0x00D8},   {0x00DE, 0x00E1},
-      {0x00E6, 0x00E6}, {0x00E8, 0x00EA},   {0x00EC, 0x00ED},
-      {0x00F0, 0x00F0}, {0x00F2, 0x00F3},   {0x00F7, 0x00FA},
-      {0x00FC, 0x00FC}, {0x00FE, 0x00FE},   {0x0101, 0x0101},
-      {0x0111, 0x0111}, {0x0113, 0x0113},   {0x011B, 0x011B},
-      {0x0126, 0x0127}, {0x012B, 0x012B},   {0x0131, 0x0133},
-      {0x0138, 0x0138}, {0x013F, 0x0142},   {0x0144, 0x0144},
-      {0x0148, 0x014B}, {0x014D, 0x014D},   {0x0152, 0x0153},
-      {0x0166, 0x0167}, {0x016B, 0x016B},   {0x01CE, 0x01CE},
-      {0x01D0, 0x01D0}, {0x01D2, 0x01D2},   {0x01D4, 0x01D4},
-      {0x01D6, 0x01D6}, {0x01D8, 0x01D8},   {0x01DA, 0x01DA},
-      {0x01DC, 0x01DC}, {0x0251, 0x0251},   {0x0261, 0x0261},
-      {0x02C4, 0x02C4}, {0x02C7, 0x02C7},   {0x02C9, 0x02CB},
-      {0x02CD, 0x02CD}, {0x02D0, 0x02D0},   {0x02D8, 0x02DB},
-      {0x02DD, 0x02DD}, {0x02DF, 0x02DF},   {0x0391, 0x03A1},
-      {0x03A3, 0x03A9}, {0x03B1, 0x03C1},   {0x03C3, 0x03C9},
-      {0x0401, 0x0401}, {0x0410, 0x044F},   {0x0451, 0x0451},
-      {0x2010, 0x2010}, {0x2013, 0x2016},   {0x2018, 0x2019},
-      {0x201C, 0x201D}, {0x2020, 0x2022},   {0x2024, 0x2027},
-      {0x2030, 0x2030}, {0x2032, 0x2033},   {0x2035, 0x2035},
-      {0x203B, 0x203B}, {0x203E, 0x203E},   {0x2074, 0x2074},
-      {0x207F, 0x207F}, {0x2081, 0x2084},   {0x20AC, 0x20AC},
-      {0x2103, 0x2103}, {0x2105, 0x2105},   {0x2109, 0x2109},
-      {0x2113, 0x2113}, {0x2116, 0x2116},   {0x2121, 0x2122},
-      {0x2126, 0x2126}, {0x212B, 0x212B},   {0x2153, 0x2154},
-      {0x215B, 0x215E}, {0x2160, 0x216B},   {0x2170, 0x2179},
-      {0x2190, 0x2199}, {0x21B8, 0x21B9},   {0x21D2, 0x21D2},
-      {0x21D4, 0x21D4}, {0x21E7, 0x21E7},   {0x2200, 0x2200},
-      {0x2202, 0x2203}, {0x2207, 0x2208},   {0x220B, 0x220B},
-      {0x220F, 0x220F}, {0x2211, 0x2211},   {0x2215, 0x2215},
-      {0x221A, 0x221A}, {0x221D, 0x2220},   {0x2223, 0x2223},
-      {0x2225, 0x2225}, {0x2227, 0x222C},   {0x222E, 0x222E},
-      {0x2234, 0x2237}, {0x223C, 0x223D},   {0x2248, 0x2248},
-      {0x224C, 0x224C}, {0x2252, 0x2252},   {0x2260, 0x2261},
-      {0x2264, 0x2267}, {0x226A, 0x226B},   {0x226E, 0x226F},
-      {0x2282, 0x2283}, {0x2286, 0x2287},   {0x2295, 0x2295},
-      {0x2299, 0x2299}, {0x22A5, 0x22A5},   {0x22BF, 0x22BF},
-      {0x2312, 0x2312}, {0x2460, 0x24E9},   {0x24EB, 0x254B},
-      {0x2550, 0x2573}, {0x2580, 0x258F},   {0x2592, 0x2595},
-      {0x25A0, 0x25A1}, {0x25A3, 0x25A9},   {0x25B2, 0x25B3},
-      {0x25B6, 0x25B7}, {0x25BC, 0x25BD},   {0x25C0, 0x25C1},
-      {0x25C6, 0x25C8}, {0x25CB, 0x25CB},   {0x25CE, 0x25D1},
-      {0x25E2, 0x25E5}, {0x25EF, 0x25EF},   {0x2605, 0x2606},
-      {0x2609, 0x2609}, {0x260E, 0x260F},   {0x2614, 0x2615},
-      {0x261C, 0x261C}, {0x261E, 0x261E},   {0x2640, 0x2640},
-      {0x2642, 0x2642}, {0x2660, 0x2661},   {0x2663, 0x2665},
-      {0x2667, 0x266A}, {0x266C, 0x266D},   {0x266F, 0x266F},
-      {0x273D, 0x273D}, {0x2776, 0x277F},   {0xE000, 0xF8FF},
-      {0xFFFD, 0xFFFD}, {0xF0000, 0xFFFFD}, {0x100000, 0x10FFFD}};
-
-  /* binary search in table of non-spacing characters */
-  if (bisearch(ucs, ambiguous, sizeof(ambiguous) / sizeof(struct interval) - 1))
-    return 2;
-
-  return mk_wcwidth(ucs);
+static inline int mk_wcwidth_cjk(char32_t ucs) {
+  if (ucs == 0)
+    return 0;
+  if (ucs < 32 || (ucs >= 0x7f && ucs < 0xa0))
+    return -1;
+
+  const int width = width_class(ucs);
+  return width == 3 ? 2 : width;
 }
 
 static inline int mk_wcswidth_cjk(const wchar_t *pwcs, size_t n) {
@@ -308,52 +187,289 @@ static inline int mk_wcswidth_cjk(const wchar_t *pwcs, size_t n) {
   return width;
 }
 
-// convert UTF-8 string to wstring
-#ifdef _MSC_VER
-static inline std::wstring utf8_decode(const std::string& s) {
-    auto r = setlocale(LC_ALL, NULL);
-    std::string curLocale;
-    if (r)
-      curLocale = r;
-    const char* _Source = s.c_str();
-    size_t _Dsize = std::strlen(_Source) + 1;
-    wchar_t* _Dest = new wchar_t[_Dsize];
-    size_t _Osize;
-    mbstowcs_s(&_Osize, _Dest, _Dsize, _Source, _Dsize);
-    std::wstring result = _Dest;
-    delete[] _Dest;
-    setlocale(LC_ALL, curLocale.c_str());
-    return result;
+// Measures a line fed to it one code point at a time, counting the grapheme
+// clusters that terminals draw as a single emoji once:
+//
+//  - emoji joined by ZERO WIDTH JOINER (U+200D), as in a family or a
+//    profession, are as wide as the first;
+//  - VARIATION SELECTOR-16 (U+FE0F) gives a narrow character such as U+2764
+//    HEAVY BLACK HEART its two column emoji presentation;
+//  - an emoji modifier (a skin tone) after an emoji adds no width;
+//  - two regional indicators form one flag.
+class ClusterWidth {
+public:
+  // Columns that ucs adds to the line, or -1 for a control character
+  INDICATORS_CONSTEXPR_WIDTH int next(char32_t ucs) {
+    const int width = mk_wcwidth(ucs);
+    if (width < 0)
+      return -1;
+    const bool joined = joined_;
+    joined_ = false;
+    if (ucs == 0x200d) {
+      joined_ = previous_ == 2;
+      return 0;
+    }
+    if (ucs == 0xfe0f) {
+      if (previous_ != 1)
+        return 0;
+      previous_ = 2;
+      return 1;
+    }
+    if (width == 0 || joined)
+      return 0;
+    if (ucs >= 0x1f3fb && ucs <= 0x1f3ff && previous_ == 2)
+      return 0;
+    const bool regional = ucs >= 0x1f1e6 && ucs <= 0x1f1ff;
+    if (regional && regional_) {
+      regional_ = false;
+      return 0;
+    }
+    regional_ = regional;
+    previous_ = width;
+    return width;
+  }
+
+  // Catches up with a run of printable ASCII characters that was measured
+  // without calling next()
+  void skip_ascii() {
+    previous_ = 1;
+    joined_ = false;
+    regional_ = false;
+  }
+
+private:
+  int previous_ = 0;      // width of the last character that was not zero width
+  bool joined_ = false;   // the last character was a ZWJ after an emoji
+  bool regional_ = false; // the last character was an unpaired regional indicator
+};
+
+// Decodes the UTF-8 sequence at it, and moves it past the sequence. A
+// malformed, overlong or truncated sequence decodes as U+FFFD and only the
+// first byte is skipped, so that measuring never needs the C library's
+// locale-dependent multibyte functions.
+static inline INDICATORS_CONSTEXPR_WIDTH char32_t utf8_next(const char *&it,
+                                                          const char *end) {
+  const auto lead = static_cast<unsigned char>(*it++);
+  if (lead < 0x80)
+    return lead;
+
+  int extra = 0;
+  char32_t ucs = 0;
+  if (lead >= 0xc2 && lead <= 0xdf) {
+    extra = 1;
+    ucs = lead & 0x1f;
+  } else if (lead >= 0xe0 && lead <= 0xef) {
+    extra = 2;
+    ucs = lead & 0x0f;
+  } else if (lead >= 0xf0 && lead <= 0xf4) {
+    extra = 3;
+    ucs = lead & 0x07;
+  } else {
+    return 0xfffd;
+  }
+
+  const char *next = it;
+  for (int i = 0; i < extra; ++i, ++next) {
+    if (next == end)
+      return 0xfffd;
+    const auto byte = static_cast<unsigned char>(*next);
+    if ((byte & 0xc0) != 0x80)
+      return 0xfffd;
+    ucs = (ucs << 6) | (byte & 0x3f);
+  }
+  if ((extra == 2 && ucs < 0x800) || (extra == 3 && (ucs < 0x10000 || ucs > 0x10ffff)) ||
+      (ucs >= 0xd800 && ucs <= 0xdfff))
+    return 0xfffd;
+
+  it = next;
+  return ucs;
 }
-#else 
-static inline std::wstring utf8_decode(const std::string& s) {
-    auto r = setlocale(LC_ALL, NULL);
-    std::string curLocale;
-    if (r)
-      curLocale = r;
-    const char* _Source = s.c_str();
-    size_t _Dsize = mbstowcs(NULL, _Source, 0) + 1;
-    wchar_t* _Dest = new wchar_t[_Dsize];
-    wmemset(_Dest, 0, _Dsize);
-    mbstowcs(_Dest, _Source, _Dsize);
-    std::wstring result = _Dest;
-    delete[] _Dest;
-    setlocale(LC_ALL, curLocale.c_str());
-    return result;
+
+// Moves past the escape sequence that starts with the ESC at it. Terminals
+// draw nothing for these, so colour codes in prefix or postfix text take no
+// columns. Recognises CSI sequences (ESC [ parameters final), OSC and the
+// other string commands (ESC ] ... terminated by BEL or ESC \), and the
+// remaining ECMA-48 escapes (ESC, intermediates, final). An unterminated
+// sequence runs to the end of the text.
+template <typename Iterator>
+INDICATORS_CONSTEXPR_WIDTH Iterator skip_escape_sequence(Iterator it, Iterator end) {
+  if (++it == end)
+    return end;
+  const auto introducer = *it++;
+  if (introducer == '[') {
+    while (it != end && !(*it >= 0x40 && *it <= 0x7e))
+      ++it;
+    return it == end ? end : it + 1;
+  }
+  if (introducer == ']' || introducer == 'P' || introducer == 'X' || introducer == '^' ||
+      introducer == '_') {
+    for (; it != end; ++it) {
+      if (*it == 0x07)
+        return it + 1;
+      if (*it == 0x1b && it + 1 != end && it[1] == '\\')
+        return it + 2;
+    }
+    return end;
+  }
+  if (introducer >= 0x20 && introducer <= 0x2f) {
+    while (it != end && *it >= 0x20 && *it <= 0x2f)
+      ++it;
+    return it == end ? end : it + 1;
+  }
+  return it;
 }
+
+static inline unsigned trailing_zeros(std::uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
 #endif
+}
+
+// Length of the run of printable ASCII characters (0x20 to 0x7e), each one
+// column wide, at the start of input. Scans 32 or 16 bytes at a time when
+// compiled for AVX2 or SSE2, and 8 at a time otherwise.
+static inline size_t printable_ascii_prefix(const char *input, size_t size) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  // Bytes of 0x80 and above are negative as signed chars, so they fail the
+  // first comparison
+  const __m256i below = _mm256_set1_epi8(0x1f);
+  const __m256i above = _mm256_set1_epi8(0x7f);
+  for (; i + 32 <= size; i += 32) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i));
+    const __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, below),
+                                               _mm256_cmpgt_epi8(above, bytes));
+    const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(printable));
+    if (mask != 0xffffffffu)
+      return i + trailing_zeros(~mask);
+  }
+#elif defined(INDICATORS_SSE2)
+  const __m128i below = _mm_set1_epi8(0x1f);
+  const __m128i above = _mm_set1_epi8(0x7f);
+  for (; i + 16 <= size; i += 16) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i));
+    const __m128i printable =
+        _mm_and_si128(_mm_cmpgt_epi8(bytes, below), _mm_cmpgt_epi8(above, bytes));
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(printable));
+    if (mask != 0xffffu)
+      return i + trailing_zeros(~mask);
+  }
+#else
+  // Sets the high bit of every byte below 0x20 or above 0x7e; exact for the
+  // word as a whole, which is all that is needed to skip it
+  const std::uint64_t ones = 0x0101010101010101ull;
+  const std::uint64_t highs = 0x8080808080808080ull;
+  for (; i + 8 <= size; i += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, input + i, sizeof(word));
+    if ((((word - ones * 0x20) & ~word) | ((word + ones) | word)) & highs)
+      break;
+  }
+#endif
+  while (i < size && static_cast<unsigned char>(input[i]) - 0x20u < 0x5fu)
+    ++i;
+  return i;
+}
 
 } // namespace details
 
-static inline int display_width(const std::string &input) {
+// Column width of UTF-8 text, or -1 if it contains a control character.
+// Escape sequences such as colour codes take no columns, and emoji sequences
+// are counted as the single glyph a terminal draws for them
+// (see details::ClusterWidth). Decodes in a single pass without allocating
+// or consulting the locale, so it is safe to call from several rendering
+// threads at once.
+static inline int display_width(const char *input, size_t size) {
   using namespace unicode::details;
-  return mk_wcswidth(utf8_decode(input).c_str(), input.size());
+  ClusterWidth clusters;
+  int width = 0;
+  for (const char *it = input, *end = input + size; it != end;) {
+    if (static_cast<unsigned char>(*it) - 0x20u < 0x5fu) {
+      const auto ascii = printable_ascii_prefix(it, size_t(end - it));
+      width += static_cast<int>(ascii);
+      it += ascii;
+      clusters.skip_ascii();
+      if (it == end)
+        break;
+    }
+    if (*it == 0x1b) {
+      it = skip_escape_sequence(it, end);
+      continue;
+    }
+    const auto ucs = utf8_next(it, end);
+    // Like mk_wcswidth(), stop at the first null character
+    if (ucs == 0)
+      break;
+    const int w = clusters.next(ucs);
+    if (w < 0)
+      return -1;
+    width += w;
+  }
+  return width;
+}
+
+static inline int display_width(const std::string &input) {
+  return display_width(input.data(), input.size());
 }
 
 static inline int display_width(const std::wstring &input) {
-  return details::mk_wcswidth(input.c_str(), input.size());
+  details::ClusterWidth clusters;
+  int width = 0;
+  for (auto it = input.begin(), end = input.end(); it != end; ++it) {
+    if (*it == 0x1b) {
+      it = details::skip_escape_sequence(it, end) - 1;
+      continue;
+    }
+    auto ucs = static_cast<char32_t>(*it);
+    // Surrogate pairs, where wchar_t is 16 bits wide
+    if (ucs >= 0xd800 && ucs <= 0xdbff && it + 1 != end && it[1] >= 0xdc00 && it[1] <= 0xdfff)
+      ucs = 0x10000 + ((ucs - 0xd800) << 10) + (static_cast<char32_t>(*++it) - 0xdc00);
+    if (ucs == 0)
+      break;
+    const int w = clusters.next(ucs);
+    if (w < 0)
+      return -1;
+    width += w;
+  }
+  return width;
 }
 
 } // namespace unicode
 
+#ifdef INDICATORS_HAS_LITERAL_WIDTH
+namespace indicators {
+
+// Column width of a UTF-8 string literal, computed at compile time by the
+// same rules as unicode::display_width(), e.g.
+//
+//   static_assert(indicators::literal_width("█") == 1);
+//
+// Only available from C++17 on.
+template <size_t N> constexpr int literal_width(const char (&text)[N]) {
+  using namespace unicode::details;
+  ClusterWidth clusters;
+  int width = 0;
+  for (const char *it = text, *end = text + N - 1; it != end;) {
+    if (*it == 0x1b) {
+      it = skip_escape_sequence(it, end);
+      continue;
+    }
+    const auto ucs = utf8_next(it, end);
+    if (ucs == 0)
+      break;
+    const int w = clusters.next(ucs);
+    if (w < 0)
+      return -1;
+    width += w;
+  }
+  return width;
+}
+
+} // namespace indicators
+#endif
+
 #endif
\ No newline at end of file
@@ -9,6 +9,9 @@
 #include <indicators/cursor_control.hpp>
 #include <indicators/cursor_movement.hpp>
 #include <indicators/details/stream_helper.hpp>
+#include <indicators/details/terminal_frame.hpp>
+#include <indicators/details/viewport.hpp>
+#include <indicators/render_scheduler.hpp>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -17,28 +20,59 @@
 namespace indicators {
 
 template <typename Indicator> class DynamicProgress {
-  using Settings = std::tuple<option::HideBarWhenComplete>;
+  using Settings = std::tuple<option::HideBarWhenComplete, option::FitToTerminal>;
 
 public:
   template <typename... Indicators> explicit DynamicProgress(Indicators &&... bars) {
     (bars_.emplace_back(std::move(bars)), ...);
-    for (auto &bar : bars_) {
-      bar->multi_progress_mode_ = true;
+    viewport_.resize(bars_.size());
+    check_state_.resize(bars_.size());
+    for (size_t i = 0; i < bars_.size(); ++i) {
+      bars_[i]->multi_progress_mode_ = true;
       ++total_count_;
       ++incomplete_count_;
+      ++running_count_;
+      check_completed(i);
     }
   }
 
+  ~DynamicProgress() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
+
   Indicator &operator[](size_t index) {
-    print_progress();
+    print_progress_if_due();
     std::lock_guard<std::mutex> lock{mutex_};
+    touch(index);
+    // The caller updates the bar after this returns, so its completion is
+    // checked on a later call
+    if (!(check_state_[index] & unchecked)) {
+      check_state_[index] |= unchecked;
+      unchecked_.push_back(index);
+    }
     return *bars_[index];
   }
 
+  void advance(size_t index, size_t n) {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      if (!bars_[index]->is_completed())
+        bars_[index]->advance(n);
+      touch(index);
+      check_completed(index);
+    }
+    print_progress_if_due();
+  }
+
   size_t push_back(std::unique_ptr<Indicator> bar) {
     std::lock_guard<std::mutex> lock{mutex_};
     bar->multi_progress_mode_ = true;
     bars_.push_back(std::move(bar));
+    viewport_.push_back();
+    check_state_.push_back(0);
+    ++running_count_;
+    check_completed(bars_.size() - 1);
     return bars_.size() - 1;
   }
 
@@ -67,6 +101,50 @@ private:
   std::vector<std::unique_ptr<Indicator>> bars_;
   std::atomic<size_t> total_count_{0};
   std::atomic<size_t> incomplete_count_{0};
+  details::TerminalFrame frame_;
+
+  // With option::FitToTerminal, the bars on screen and the lines last drawn
+  details::Viewport viewport_;
+  size_t drawn_lines_{0};
+
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  // Bars handed out by operator[] since their completion was last checked,
+  // and the bars not yet counted as completed, so that telling whether every
+  // bar has completed costs as much as the updates since the last check
+  enum : unsigned char { unchecked = 1, counted_completed = 2 };
+  std::vector<unsigned char> check_state_;
+  std::vector<size_t> unchecked_;
+  std::atomic<size_t> running_count_{0};
+
+  void check_completed(size_t index) {
+    if (!(check_state_[index] & counted_completed) && bars_[index]->is_completed()) {
+      check_state_[index] |= counted_completed;
+      --running_count_;
+    }
+  }
+
+  // Leaves the frame to the RenderScheduler when attached to it, unless every
+  // bar has completed
+  void print_progress_if_due() {
+    if (render_scheduled_) {
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        for (auto index : unchecked_) {
+          check_state_[index] &= ~unchecked;
+          check_completed(index);
+        }
+        unchecked_.clear();
+      }
+      if (running_count_ != 0) {
+        RenderScheduler::instance().notify(render_pending_);
+        return;
+      }
+    }
+    print_progress();
+  }
 
   template <details::ProgressBarOption id>
   auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value)) {
@@ -79,24 +157,71 @@ private:
     return details::get_value<id>(settings_).value;
   }
 
+  void draw_line(Indicator &bar) {
+    bar.append_line(frame_.begin_line());
+    frame_.end_line();
+  }
+
+  void touch(size_t index) {
+    if (get_value<details::ProgressBarOption::fit_to_terminal>())
+      viewport_.touch(index);
+  }
+
+  // Draws as many bars as fit above the cursor and a summary of the others,
+  // redrawing all of these lines each time
+  void draw_viewport(std::ostream &os) {
+    viewport_.layout(details::Viewport::lines(os),
+                     get_value<details::ProgressBarOption::hide_bar_when_complete>(),
+                     [this](size_t index) { return bars_[index]->is_completed(); });
+
+    if (started_)
+      frame_.move_up(drawn_lines_);
+    for (auto index : viewport_.rows()) {
+      frame_.erase_line();
+      draw_line(*bars_[index]);
+    }
+    size_t lines_drawn = viewport_.rows().size();
+    if (viewport_.hidden()) {
+      frame_.erase_line();
+      viewport_.write_summary(frame_.begin_line());
+      frame_.end_line();
+      ++lines_drawn;
+    }
+    // Clears what is left of a taller frame
+    for (size_t i = lines_drawn; i < drawn_lines_; ++i) {
+      frame_.erase_line();
+      frame_.end_line();
+    }
+    if (drawn_lines_ > lines_drawn)
+      frame_.move_up(drawn_lines_ - lines_drawn);
+    drawn_lines_ = lines_drawn;
+    if (!started_)
+      started_ = true;
+  }
+
 public:
+  // The whole frame goes to the stream of the first bar in one write
   void print_progress() {
     std::lock_guard<std::mutex> lock{mutex_};
+    auto &os = bars_.empty()
+                   ? std::cout
+                   : bars_[0]->template get_value<details::ProgressBarOption::stream>();
+    frame_.begin(os);
     auto &hide_bar_when_complete = get_value<details::ProgressBarOption::hide_bar_when_complete>();
-    if (hide_bar_when_complete) {
+    if (get_value<details::ProgressBarOption::fit_to_terminal>()) {
+      draw_viewport(os);
+    } else if (hide_bar_when_complete) {
       // Hide completed bars
       if (started_) {
         for (size_t i = 0; i < incomplete_count_; ++i) {
-          move_up(1);
-          erase_line();
-          std::cout << std::flush;
+          frame_.move_up(1);
+          frame_.erase_line();
         }
       }
       incomplete_count_ = 0;
       for (auto &bar : bars_) {
         if (!bar->is_completed()) {
-          bar->print_progress(true);
-          std::cout << "\n";
+          draw_line(*bar);
           ++incomplete_count_;
         }
       }
@@ -105,16 +230,14 @@ public:
     } else {
       // Don't hide any bars
       if (started_)
-        move_up(static_cast<int>(total_count_));
-      for (auto &bar : bars_) {
-        bar->print_progress(true);
-        std::cout << "\n";
-      }
+        frame_.move_up(total_count_);
+      for (auto &bar : bars_)
+        draw_line(*bar);
       if (!started_)
         started_ = true;
     }
     total_count_ = bars_.size();
-    std::cout << termcolor::reset;
+    frame_.end();
   }
 };
 
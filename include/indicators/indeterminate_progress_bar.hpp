@@ -2,13 +2,17 @@
 #ifndef INDICATORS_INDETERMINATE_PROGRESS_BAR
 #define INDICATORS_INDETERMINATE_PROGRESS_BAR
 
+#include <indicators/details/frame_buffer.hpp>
+#include <indicators/details/redraw_throttle.hpp>
 #include <indicators/details/stream_helper.hpp>
+#include <indicators/details/width_cache.hpp>
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 #include <indicators/color.hpp>
+#include <indicators/render_scheduler.hpp>
 #include <indicators/setting.hpp>
 #include <indicators/terminal_size.hpp>
 #include <iomanip>
@@ -18,7 +22,6 @@
 #include <thread>
 #include <tuple>
 #include <type_traits>
-#include <sstream>
 #include <utility>
 
 namespace indicators {
@@ -27,7 +30,8 @@ class IndeterminateProgressBar {
   using Settings =
       std::tuple<option::BarWidth, option::PrefixText, option::PostfixText, option::Start,
                  option::End, option::Fill, option::Lead, option::MaxPostfixTextLen,
-                 option::Completed, option::ForegroundColor, option::FontStyles, option::Stream>;
+                 option::Completed, option::ForegroundColor, option::FontStyles, option::Stream,
+                 option::MinRedrawInterval>;
 
   enum class Direction { forward, backward };
 
@@ -62,7 +66,10 @@ public:
                   details::get<details::ProgressBarOption::font_styles>(
                       option::FontStyles{std::vector<FontStyle>{}}, std::forward<Args>(args)...),
                   details::get<details::ProgressBarOption::stream>(option::Stream{std::cout},
-                                                                   std::forward<Args>(args)...)) {
+                                                                   std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::min_redraw_interval>(
+                      option::MinRedrawInterval{std::chrono::nanoseconds::zero()},
+                      std::forward<Args>(args)...)) {
     // starts with [<==>...........]
     // progress_ = 0
 
@@ -77,6 +84,11 @@ public:
                     get_value<details::ProgressBarOption::end>().size();
   }
 
+  ~IndeterminateProgressBar() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
+
   template <typename T, details::ProgressBarOption id>
   void set_option(details::Setting<T, id> &&setting) {
     static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(
@@ -84,6 +96,12 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = std::move(setting).value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    if (details::ProgressScale::depends_on(id))
+      scale_stale_ = true;
+    text_widths_.invalidate(id);
+    ++settings_version_;
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -93,6 +111,12 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = setting.value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    if (details::ProgressScale::depends_on(id))
+      scale_stale_ = true;
+    text_widths_.invalidate(id);
+    ++settings_version_;
   }
 
   void set_option(
@@ -102,6 +126,8 @@ public:
     if (setting.value.length() > get_value<details::ProgressBarOption::max_postfix_text_len>()) {
       get_value<details::ProgressBarOption::max_postfix_text_len>() = setting.value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
   void
@@ -112,6 +138,8 @@ public:
     if (new_value.length() > get_value<details::ProgressBarOption::max_postfix_text_len>()) {
       get_value<details::ProgressBarOption::max_postfix_text_len>() = new_value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
   void tick() {
@@ -128,14 +156,20 @@ public:
         direction_ = Direction::forward;
       }
     }
-    print_progress();
+    if (render_scheduled_) {
+      RenderScheduler::instance().notify(render_pending_);
+      return;
+    }
+    if (!throttle_.is_due(get_value<details::ProgressBarOption::min_redraw_interval>()))
+      return;
+    print_progress_if_changed();
   }
 
   bool is_completed() { return get_value<details::ProgressBarOption::completed>(); }
 
   void mark_as_completed() {
     get_value<details::ProgressBarOption::completed>() = true;
-    print_progress();
+    print_progress_if_changed();
   }
 
 private:
@@ -155,83 +189,157 @@ private:
   Settings settings_;
   std::chrono::nanoseconds elapsed_;
   std::mutex mutex_;
+  details::RedrawThrottle throttle_;
+  // Bumped by set_option() so that a changed setting forces a redraw;
+  // starts ahead of last_state_ so that the first frame is always drawn.
+  size_t settings_version_{1};
+  details::VisibleState last_state_;
+  details::FrameBuffer frame_;
+  // Rebuilt before the next frame whenever set_option() changes a glyph, or
+  // the colour or font styles
+  details::ProgressScale scale_;
+  bool scale_stale_{true};
+  details::StylePrefix style_;
+  bool style_stale_{true};
+  // Display widths of the prefix, postfix, start and end texts
+  details::TextWidths text_widths_;
 
   template <typename Indicator, size_t count> friend class MultiProgress;
   template <typename Indicator> friend class DynamicProgress;
   std::atomic<bool> multi_progress_mode_{false};
 
-  std::pair<std::string, int> get_prefix_text() {
-    std::stringstream os;
-    os << get_value<details::ProgressBarOption::prefix_text>();
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  details::VisibleState visible_state() const {
+    details::VisibleState state;
+    state.cells = progress_;
+    state.settings_version = settings_version_;
+    state.completed = get_value<details::ProgressBarOption::completed>();
+    return state;
   }
 
-  std::pair<std::string, int> get_postfix_text() {
-    std::stringstream os;
-    os << " " << get_value<details::ProgressBarOption::postfix_text>();
+  // Whether the line last drawn for MultiProgress no longer shows the current
+  // state, so that it only redraws the bars that changed
+  bool changed_since_drawn() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return visible_state() != last_state_;
+  }
 
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+  // Appends the prefix text to frame_ and returns its display width
+  int write_prefix_text() {
+    const auto &prefix_text = get_value<details::ProgressBarOption::prefix_text>();
+    frame_ << prefix_text;
+    return text_widths_.prefix.get(prefix_text);
   }
 
-public:
-  void print_progress(bool from_multi_progress = false) {
-    std::lock_guard<std::mutex> lock{mutex_};
+  // Appends the postfix text to frame_ and returns its display width
+  int write_postfix_text() {
+    const auto &postfix_text = get_value<details::ProgressBarOption::postfix_text>();
+    const auto postfix_width = text_widths_.postfix.get(postfix_text);
+    frame_ << ' ' << postfix_text;
+    return postfix_width == -1 ? -1 : 1 + postfix_width;
+  }
 
+  // Skips the frame if_changed and it would look the same as the last one.
+  // Updates skip it; MultiProgress, which has moved the cursor onto this
+  // line, and explicit calls to print_progress() always draw.
+  void draw_progress(bool from_multi_progress, bool if_changed = false) {
     auto &os = get_value<details::ProgressBarOption::stream>();
 
     if (multi_progress_mode_ && !from_multi_progress) {
       return;
     }
-    if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
-      details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
-
-    for (auto &style : get_value<details::ProgressBarOption::font_styles>())
-      details::set_font_style(os, style);
 
-    const auto prefix_pair = get_prefix_text();
-    const auto prefix_text = prefix_pair.first;
-    const auto prefix_length = prefix_pair.second;
-    os << "\r" << prefix_text;
-
-    os << get_value<details::ProgressBarOption::start>();
-
-    details::IndeterminateProgressScaleWriter writer{
-        os, get_value<details::ProgressBarOption::bar_width>(),
-        get_value<details::ProgressBarOption::fill>(),
-        get_value<details::ProgressBarOption::lead>()};
+    const auto state = visible_state();
+    if (if_changed && state == last_state_)
+      return;
+    last_state_ = state;
+    frame_.clear();
+    if (style_stale_) {
+      style_.assign(get_value<details::ProgressBarOption::foreground_color>(),
+                    get_value<details::ProgressBarOption::font_styles>());
+      style_stale_ = false;
+    }
+    style_.write(frame_, os);
+    frame_ << '\r';
+    const auto prefix_length = write_prefix_text();
+
+    frame_ << get_value<details::ProgressBarOption::start>();
+
+    if (scale_stale_) {
+      scale_.assign(get_value<details::ProgressBarOption::bar_width>(),
+                    get_value<details::ProgressBarOption::fill>(),
+                    get_value<details::ProgressBarOption::lead>(),
+                    get_value<details::ProgressBarOption::fill>());
+      scale_stale_ = false;
+    }
+    details::IndeterminateProgressScaleWriter writer{frame_, scale_};
     writer.write(progress_);
 
-    os << get_value<details::ProgressBarOption::end>();
+    frame_ << get_value<details::ProgressBarOption::end>();
 
-    const auto postfix_pair = get_postfix_text();
-    const auto postfix_text = postfix_pair.first;
-    const auto postfix_length = postfix_pair.second;
-    os << postfix_text;
+    const auto postfix_length = write_postfix_text();
 
     // Get length of prefix text and postfix text
-    const auto start_length = get_value<details::ProgressBarOption::start>().size();
+    const auto start_length =
+        text_widths_.start.get(get_value<details::ProgressBarOption::start>());
     const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
-    const auto end_length = get_value<details::ProgressBarOption::end>().size();
-    const auto terminal_width = terminal_size().second;
-    // prefix + bar_width + postfix should be <= terminal_width
-    const int remaining = terminal_width - (prefix_length + start_length + bar_width + end_length + postfix_length);
-    if (prefix_length == -1 || postfix_length == -1) {
-      os << "\r";
+    const auto end_length = text_widths_.end.get(get_value<details::ProgressBarOption::end>());
+    const auto terminal_width = terminal_size(os).second;
+    // prefix + bar_width + postfix should be <= terminal_width; a stream that
+    // is not a terminal has no line to pad
+    const int remaining =
+        terminal_width > 0
+            ? int(terminal_width) - int(prefix_length + start_length + bar_width + end_length +
+                                        postfix_length)
+            : 0;
+    if (prefix_length == -1 || postfix_length == -1 || start_length == -1 ||
+        end_length == -1) {
+      frame_ << '\r';
     } else if (remaining > 0) {
-      os << std::string(remaining, ' ') << "\r";
+      frame_.append(remaining, ' ') << '\r';
     } else if (remaining < 0) {
       // Do nothing. Maybe in the future truncate postfix with ...
     }
-    os.flush();
+    throttle_.redrawn();
 
-    if (get_value<details::ProgressBarOption::completed>() &&
-        !from_multi_progress) // Don't std::endl if calling from MultiProgress
+    // MultiProgress and DynamicProgress write frame_ along with the lines of
+    // their other bars, and end the lines themselves
+    if (from_multi_progress)
+      return;
+    frame_.write_to(os);
+    os.flush();
+    if (get_value<details::ProgressBarOption::completed>())
       os << termcolor::reset << std::endl;
   }
+
+  // Draws a frame for an update, unless it would look the same as the last
+  // one
+  void print_progress_if_changed() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(false, true);
+  }
+
+  // Draws this bar's line into frame without writing it, for MultiProgress
+  // and DynamicProgress, which write the lines of all their bars at once
+  void append_line(details::FrameBuffer &frame) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(true);
+    frame.append(frame_.data(), frame_.size());
+  }
+
+public:
+  void print_progress(bool from_multi_progress = false) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(from_multi_progress);
+    if (from_multi_progress) {
+      auto &os = get_value<details::ProgressBarOption::stream>();
+      frame_.write_to(os);
+      os.flush();
+    }
+  }
 };
 
 } // namespace indicators
@@ -4,16 +4,24 @@
 #include <atomic>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <mutex>
 #include <vector>
 
 #include <indicators/color.hpp>
 #include <indicators/cursor_movement.hpp>
 #include <indicators/details/stream_helper.hpp>
+#include <indicators/details/terminal_frame.hpp>
+#include <indicators/details/viewport.hpp>
+#include <indicators/render_scheduler.hpp>
 
 namespace indicators {
 
-template <typename Indicator, size_t count> class MultiProgress {
+// The count of a MultiProgress whose number of bars is only known at run time
+constexpr size_t dynamic_count = static_cast<size_t>(-1);
+
+template <typename Indicator, size_t count = dynamic_count> class MultiProgress {
 public:
   template <typename... Indicators,
             typename = typename std::enable_if<(sizeof...(Indicators) == count)>::type>
@@ -24,25 +32,37 @@ public:
     }
   }
 
+  ~MultiProgress() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
+
   template <size_t index>
   typename std::enable_if<(index >= 0 && index < count), void>::type set_progress(size_t value) {
     if (!bars_[index].get().is_completed())
       bars_[index].get().set_progress(value);
-    print_progress();
+    print_progress_if_due();
   }
 
   template <size_t index>
   typename std::enable_if<(index >= 0 && index < count), void>::type set_progress(float value) {
     if (!bars_[index].get().is_completed())
       bars_[index].get().set_progress(value);
-    print_progress();
+    print_progress_if_due();
   }
 
   template <size_t index>
   typename std::enable_if<(index >= 0 && index < count), void>::type tick() {
     if (!bars_[index].get().is_completed())
       bars_[index].get().tick();
-    print_progress();
+    print_progress_if_due();
+  }
+
+  template <size_t index>
+  typename std::enable_if<(index >= 0 && index < count), void>::type advance(size_t n) {
+    if (!bars_[index].get().is_completed())
+      bars_[index].get().advance(n);
+    print_progress_if_due();
   }
 
   template <size_t index>
@@ -52,8 +72,47 @@ public:
 
 private:
   std::atomic<bool> started_{false};
+  // Whether a change has not been drawn yet by a frame
+  std::atomic<bool> redraw_pending_{false};
   std::mutex mutex_;
   std::vector<std::reference_wrapper<Indicator>> bars_;
+  details::TerminalFrame frame_;
+
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  // Leaves the frame to the RenderScheduler when attached to it, unless this
+  // update completed the last bar
+  void print_progress_if_due() {
+    if (render_scheduled_ && !_all_completed()) {
+      RenderScheduler::instance().notify(render_pending_);
+      return;
+    }
+    redraw_pending_ = true;
+    draw_pending_frames();
+  }
+
+  // Ticks from many threads share frames instead of queueing for them. The
+  // thread that gets the lock draws frames until no change is pending, each
+  // covering every change made before it began; the others do not wait for
+  // the lock, since their changes are left to the frame being drawn or to
+  // the next one. Checking again after unlocking catches the changes of
+  // threads that found the lock taken just before it was released.
+  //
+  // An update can still wait while a frame formats the line of its own bar:
+  // BlockProgressBar, ProgressSpinner and IndeterminateProgressBar take the
+  // bar's mutex to update it, and so does the tick that completes a
+  // ProgressBar.
+  void draw_pending_frames() {
+    while (redraw_pending_) {
+      std::unique_lock<std::mutex> lock{mutex_, std::try_to_lock};
+      if (!lock.owns_lock())
+        return;
+      while (redraw_pending_.exchange(false))
+        draw_frame();
+    }
+  }
 
   bool _all_completed() {
     bool result{true};
@@ -62,19 +121,281 @@ private:
     return result;
   }
 
-public:
-  void print_progress() {
-    std::lock_guard<std::mutex> lock{mutex_};
-    if (started_)
-      move_up(count);
-    for (auto &bar : bars_) {
-      bar.get().print_progress(true);
-      std::cout << "\n";
+  // The first frame draws every bar. Later frames leave the lines of bars
+  // that have not changed alone: the cursor, which rests below the last bar,
+  // moves to each changed line in turn and back down after the last one.
+  // The whole frame goes to the stream of the first bar in one write.
+  void draw_frame() {
+    frame_.begin(bars_[0].get().template get_value<details::ProgressBarOption::stream>());
+    size_t row = started_ ? count : 0;
+    for (size_t i = 0; i < count; ++i) {
+      auto &bar = bars_[i].get();
+      if (started_ && !bar.changed_since_drawn())
+        continue;
+      if (row > i)
+        frame_.move_up(row - i);
+      else if (row < i)
+        frame_.move_down(i - row);
+      bar.append_line(frame_.begin_line());
+      frame_.end_line();
+      row = i + 1;
     }
-    std::cout << termcolor::reset;
+    if (row < count)
+      frame_.move_down(count - row);
+    frame_.end();
     if (!started_)
       started_ = true;
   }
+
+public:
+  // Waits for a frame being drawn by another thread, then draws one
+  void print_progress() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      redraw_pending_ = false;
+      draw_frame();
+    }
+    draw_pending_frames();
+  }
+};
+
+// MultiProgress over a number of bars chosen at run time, for workloads with
+// thousands of tasks. The bars are given as a range of bars or of pointers to
+// bars, and sit in one contiguous array next to a dirty flag each. An update
+// sets the flag of its bar and, the first time only, adds the bar to a list
+// of dirty bars, so that a frame looks at the bars that were updated since
+// the last one and at the rows on screen, never at every bar. A bar that is
+// not updated is not redrawn either, so its elapsed time only moves on with
+// its progress.
+//
+// When there are more bars than terminal rows, the bars share the rows as
+// with option::FitToTerminal in DynamicProgress: the bars that fit are drawn,
+// chosen by details::Viewport, above a summary of the others.
+template <typename Indicator> class MultiProgress<Indicator, dynamic_count> {
+public:
+  template <typename Iterator>
+  MultiProgress(Iterator first, Iterator last)
+      : count_(static_cast<size_t>(std::distance(first, last))), slots_(new Slot[count_]),
+        incomplete_(count_) {
+    for (size_t i = 0; first != last; ++first, ++i) {
+      auto &bar = indicator(*first);
+      bar.multi_progress_mode_ = true;
+      slots_[i].bar = &bar;
+      if (bar.is_completed()) {
+        slots_[i].completed = true;
+        --incomplete_;
+      }
+    }
+    // Each bar is on the list at most once, so neither list ever grows
+    dirty_.reserve(count_);
+    drawing_.reserve(count_);
+    viewport_.resize(count_);
+  }
+
+  ~MultiProgress() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
+
+  size_t size() const { return count_; }
+
+  void set_progress(size_t index, size_t value) {
+    auto &bar = *slots_[index].bar;
+    if (!bar.is_completed())
+      bar.set_progress(value);
+    updated(index);
+  }
+
+  void set_progress(size_t index, float value) {
+    auto &bar = *slots_[index].bar;
+    if (!bar.is_completed())
+      bar.set_progress(value);
+    updated(index);
+  }
+
+  void tick(size_t index) {
+    auto &bar = *slots_[index].bar;
+    if (!bar.is_completed())
+      bar.tick();
+    updated(index);
+  }
+
+  void advance(size_t index, size_t n) {
+    auto &bar = *slots_[index].bar;
+    if (!bar.is_completed())
+      bar.advance(n);
+    updated(index);
+  }
+
+  bool is_completed(size_t index) const { return slots_[index].bar->is_completed(); }
+
+  // Waits for a frame being drawn by another thread, then draws one
+  void print_progress() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      redraw_pending_ = false;
+      draw_frame();
+    }
+    draw_pending_frames();
+  }
+
+private:
+  // Gives every bar its own row if they all fit, or else lays them out with
+  // the viewport. Then walks the rows top to bottom and draws those whose
+  // bar has changed, or was updated and no longer looks the same, and the
+  // summary line if its numbers have changed. The cursor rests below the
+  // last line.
+  void draw_frame() {
+    if (count_ == 0)
+      return;
+    {
+      std::lock_guard<std::mutex> dirty_lock{dirty_mutex_};
+      drawing_.swap(dirty_);
+    }
+    // Cleared before the bars are read, so that an update made while this
+    // frame is drawn puts its bar back on the list for the next one
+    for (auto index : drawing_) {
+      slots_[index].dirty = false;
+      slots_[index].in_frame = true;
+      viewport_.touch(index);
+    }
+
+    auto &os = slots_[0].bar->template get_value<details::ProgressBarOption::stream>();
+    frame_.begin(os);
+    const size_t height = details::Viewport::lines(os);
+    const bool fits = count_ <= height;
+    if (fits) {
+      for (size_t i = all_rows_.size(); i < count_; ++i)
+        all_rows_.push_back(i);
+    } else {
+      viewport_.layout(height, false,
+                       [this](size_t index) { return slots_[index].bar->is_completed(); });
+    }
+    const auto &rows = fits ? all_rows_ : viewport_.rows();
+    const size_t hidden = fits ? 0 : viewport_.hidden();
+    const size_t hidden_done = fits ? 0 : viewport_.hidden_done();
+    const size_t lines = rows.size() + (hidden ? 1 : 0);
+
+    size_t row = drawn_lines_;
+    for (size_t i = 0; i < rows.size(); ++i) {
+      auto &slot = slots_[rows[i]];
+      const bool replaced = i >= drawn_rows_.size() || drawn_rows_[i] != rows[i];
+      if (!replaced && !(slot.in_frame && slot.bar->changed_since_drawn()))
+        continue;
+      move_cursor(row, i);
+      if (replaced && i < drawn_lines_)
+        frame_.erase_line();
+      slot.bar->append_line(frame_.begin_line());
+      frame_.end_line();
+      row = i + 1;
+    }
+    if (hidden) {
+      const size_t i = rows.size();
+      if (i != drawn_rows_.size() || i >= drawn_lines_ || hidden != drawn_hidden_ ||
+          hidden_done != drawn_hidden_done_) {
+        move_cursor(row, i);
+        if (i < drawn_lines_)
+          frame_.erase_line();
+        viewport_.write_summary(frame_.begin_line());
+        frame_.end_line();
+        row = i + 1;
+      }
+    }
+    // Clears what is left of a taller frame
+    for (size_t i = lines; i < drawn_lines_; ++i) {
+      move_cursor(row, i);
+      frame_.erase_line();
+      frame_.end_line();
+      row = i + 1;
+    }
+    move_cursor(row, lines);
+    frame_.end();
+
+    for (auto index : drawing_)
+      slots_[index].in_frame = false;
+    drawing_.clear();
+    drawn_rows_.assign(rows.begin(), rows.end());
+    drawn_lines_ = lines;
+    drawn_hidden_ = hidden;
+    drawn_hidden_done_ = hidden_done;
+  }
+
+  void move_cursor(size_t from, size_t to) {
+    if (from > to)
+      frame_.move_up(from - to);
+    else if (from < to)
+      frame_.move_down(to - from);
+  }
+
+  // Draws frames for the pending changes unless another thread is drawing
+  // them, as in MultiProgress<Indicator, count>
+  void draw_pending_frames() {
+    while (redraw_pending_) {
+      std::unique_lock<std::mutex> lock{mutex_, std::try_to_lock};
+      if (!lock.owns_lock())
+        return;
+      while (redraw_pending_.exchange(false))
+        draw_frame();
+    }
+  }
+
+  struct Slot {
+    Indicator *bar{nullptr};
+    std::atomic<bool> dirty{false};
+    // Whether the bar has been counted out of incomplete_
+    std::atomic<bool> completed{false};
+    // Whether the bar is on the list of the frame being drawn
+    bool in_frame{false};
+  };
+
+  static Indicator &indicator(Indicator &bar) { return bar; }
+  static Indicator &indicator(std::reference_wrapper<Indicator> bar) { return bar.get(); }
+  template <typename Pointer> static Indicator &indicator(Pointer &bar) { return *bar; }
+
+  size_t count_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<size_t> incomplete_;
+  std::atomic<bool> redraw_pending_{false};
+  std::mutex mutex_;
+  details::TerminalFrame frame_;
+
+  // The bars on screen when they do not all fit, the rows when they do, and
+  // what the last frame drew: the bar on each row, the number of lines, and
+  // the numbers on the summary line
+  details::Viewport viewport_;
+  std::vector<size_t> all_rows_;
+  std::vector<size_t> drawn_rows_;
+  size_t drawn_lines_{0};
+  size_t drawn_hidden_{0};
+  size_t drawn_hidden_done_{0};
+
+  // Bars updated since the last frame, in the order of their first update,
+  // and the list that the frame being drawn took over
+  std::mutex dirty_mutex_;
+  std::vector<size_t> dirty_;
+  std::vector<size_t> drawing_;
+
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  // Marks bar index for the next frame and draws it, or leaves it to the
+  // RenderScheduler when attached to it, unless every bar is completed
+  void updated(size_t index) {
+    auto &slot = slots_[index];
+    if (!slot.dirty.exchange(true)) {
+      std::lock_guard<std::mutex> lock{dirty_mutex_};
+      dirty_.push_back(index);
+    }
+    if (slot.bar->is_completed() && !slot.completed.exchange(true))
+      --incomplete_;
+    if (render_scheduled_ && incomplete_ != 0) {
+      RenderScheduler::instance().notify(render_pending_);
+      return;
+    }
+    redraw_pending_ = true;
+    draw_pending_frames();
+  }
 };
 
 } // namespace indicators
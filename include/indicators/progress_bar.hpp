@@ -2,18 +2,23 @@
 #ifndef INDICATORS_PROGRESS_BAR
 #define INDICATORS_PROGRESS_BAR
 
+#include <indicators/details/frame_buffer.hpp>
+#include <indicators/details/redraw_throttle.hpp>
+#include <indicators/details/sharded_counter.hpp>
 #include <indicators/details/stream_helper.hpp>
+#include <indicators/details/width_cache.hpp>
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 #include <indicators/color.hpp>
+#include <indicators/render_scheduler.hpp>
 #include <indicators/setting.hpp>
 #include <indicators/terminal_size.hpp>
 #include <iomanip>
 #include <iostream>
-#include <sstream>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -32,7 +37,8 @@ class ProgressBar {
                  option::ShowElapsedTime, option::ShowRemainingTime,
                  option::SavedStartTime, option::ForegroundColor,
                  option::FontStyles, option::MinProgress, option::MaxProgress,
-                 option::ProgressType, option::Stream>;
+                 option::ProgressType, option::Stream,
+                 option::MinRedrawInterval, option::ShardedProgress>;
 
 public:
   template <typename... Args,
@@ -84,7 +90,12 @@ public:
                 option::ProgressType{ProgressType::incremental},
                 std::forward<Args>(args)...),
             details::get<details::ProgressBarOption::stream>(
-                option::Stream{std::cout}, std::forward<Args>(args)...)) {
+                option::Stream{std::cout}, std::forward<Args>(args)...),
+            details::get<details::ProgressBarOption::min_redraw_interval>(
+                option::MinRedrawInterval{std::chrono::nanoseconds::zero()},
+                std::forward<Args>(args)...),
+            details::get<details::ProgressBarOption::sharded_progress>(
+                option::ShardedProgress{false}, std::forward<Args>(args)...)) {
 
     // if progress is incremental, start from min_progress
     // else start from max_progress
@@ -93,6 +104,15 @@ public:
       progress_ = get_value<details::ProgressBarOption::min_progress>();
     else
       progress_ = get_value<details::ProgressBarOption::max_progress>();
+    completed_ = get_value<details::ProgressBarOption::completed>();
+    refresh_limits();
+    if (get_value<details::ProgressBarOption::sharded_progress>())
+      shards_.reset(new details::ShardedCounter);
+  }
+
+  ~ProgressBar() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -103,6 +123,13 @@ public:
         "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = std::move(setting).value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    if (details::ProgressScale::depends_on(id))
+      scale_stale_ = true;
+    text_widths_.invalidate(id);
+    refresh_limits();
+    ++settings_version_;
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -113,6 +140,13 @@ public:
         "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = setting.value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    if (details::ProgressScale::depends_on(id))
+      scale_stale_ = true;
+    text_widths_.invalidate(id);
+    refresh_limits();
+    ++settings_version_;
   }
 
   void
@@ -125,6 +159,8 @@ public:
       get_value<details::ProgressBarOption::max_postfix_text_len>() =
           setting.value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
   void set_option(
@@ -139,45 +175,74 @@ public:
       get_value<details::ProgressBarOption::max_postfix_text_len>() =
           new_value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
-  void set_progress(size_t new_progress) {
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      progress_ = new_progress;
-    }
+  void set_option(
+      const details::Setting<bool, details::ProgressBarOption::completed>
+          &setting) {
+    completed_ = setting.value;
+  }
 
-    save_start_time();
-    print_progress();
+  void set_option(
+      details::Setting<bool, details::ProgressBarOption::completed> &&setting) {
+    completed_ = setting.value;
   }
 
-  void tick() {
-    {
-      std::lock_guard<std::mutex> lock{mutex_};
-      const auto type = get_value<details::ProgressBarOption::progress_type>();
-      if (type == ProgressType::incremental)
-        progress_ += 1;
-      else
-        progress_ -= 1;
-    }
-    save_start_time();
-    print_progress();
+  // With ShardedProgress, the shards are cleared before the new value is
+  // stored, so a tick that runs concurrently counts either before the new
+  // value, which replaces it, or on top of it; none is lost.
+  void set_progress(size_t new_progress) {
+    if (shards_)
+      shards_->reset();
+    progress_.store(new_progress, std::memory_order_relaxed);
+    print_progress_if_due(new_progress);
   }
 
-  size_t current() {
-    std::lock_guard<std::mutex> lock{mutex_};
-    return (std::min)(
-        progress_,
-        size_t(get_value<details::ProgressBarOption::max_progress>()));
+  void tick() { advance(1); }
+
+  void advance(size_t n) {
+    const bool decremental = decremental_.load(std::memory_order_relaxed);
+    if (shards_) {
+      shards_->add(decremental ? -static_cast<long long>(n) : static_cast<long long>(n));
+      // Only a frame that is due, or a tick close enough to the end that it
+      // may have reached it, pays for summing the shards
+      if (may_be_final_sharded())
+        print_progress_if_due(load_progress());
+      else if (render_scheduled_)
+        RenderScheduler::instance().notify(render_pending_);
+      else if (throttle_.is_due(min_redraw_interval()))
+        print_progress_if_due(load_progress());
+      return;
+    }
+    if (!decremental) {
+      print_progress_if_due(progress_.fetch_add(n, std::memory_order_relaxed) + n);
+      return;
+    }
+    // Stops at MinProgress instead of wrapping around below zero, where the
+    // bar would look full and never complete
+    const size_t min_progress = min_progress_.load(std::memory_order_relaxed);
+    size_t progress = progress_.load(std::memory_order_relaxed);
+    size_t new_progress;
+    do {
+      new_progress = progress > min_progress && progress - min_progress > n
+                         ? progress - n
+                         : (std::min)(progress, min_progress);
+    } while (!progress_.compare_exchange_weak(progress, new_progress,
+                                              std::memory_order_relaxed));
+    print_progress_if_due(new_progress);
   }
 
-  bool is_completed() const {
-    return get_value<details::ProgressBarOption::completed>();
+  size_t current() const {
+    return (std::min)(load_progress(), max_progress_.load(std::memory_order_relaxed));
   }
 
+  bool is_completed() const { return completed_; }
+
   void mark_as_completed() {
-    get_value<details::ProgressBarOption::completed>() = true;
-    print_progress();
+    completed_ = true;
+    print_progress_if_changed();
   }
 
 private:
@@ -193,16 +258,114 @@ private:
     return details::get_value<id>(settings_).value;
   }
 
-  size_t progress_{0};
+  std::atomic<size_t> progress_{0};
+  // With option::ShardedProgress, ticks accumulate here instead of in
+  // progress_, which then only holds the value last given to set_progress()
+  std::unique_ptr<details::ShardedCounter> shards_;
+  std::atomic<bool> completed_{false};
   Settings settings_;
+  // Copies of max_progress, min_progress, progress_type and
+  // min_redraw_interval, kept by refresh_limits()
+  std::atomic<size_t> min_progress_{0};
+  std::atomic<size_t> max_progress_{0};
+  std::atomic<bool> decremental_{false};
+  std::atomic<long long> min_redraw_interval_{0};
   std::chrono::nanoseconds elapsed_;
   std::chrono::time_point<std::chrono::high_resolution_clock> start_time_point_;
   std::mutex mutex_;
+  details::RedrawThrottle throttle_;
+  // Bumped by set_option() so that a changed setting forces a redraw;
+  // starts ahead of last_state_ so that the first frame is always drawn.
+  size_t settings_version_{1};
+  details::VisibleState last_state_;
+  details::FrameBuffer frame_;
+  // Rebuilt before the next frame whenever set_option() changes a glyph, or
+  // the colour or font styles
+  details::ProgressScale scale_;
+  bool scale_stale_{true};
+  details::StylePrefix style_;
+  bool style_stale_{true};
+  // Display widths of the prefix, postfix, start and end texts
+  details::TextWidths text_widths_;
 
   template <typename Indicator, size_t count> friend class MultiProgress;
   template <typename Indicator> friend class DynamicProgress;
   std::atomic<bool> multi_progress_mode_{false};
 
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  size_t load_progress() const {
+    const auto progress = progress_.load(std::memory_order_relaxed);
+    if (!shards_)
+      return progress;
+    // Decremental ticks past zero count as zero rather than wrapping around
+    const auto sum = shards_->sum();
+    return sum < 0 && static_cast<size_t>(-sum) > progress ? 0
+                                                           : progress + static_cast<size_t>(sum);
+  }
+
+  // Copies the settings that tick() and set_progress() read without the
+  // lock; called under the lock whenever set_option() may have changed them
+  void refresh_limits() {
+    min_progress_.store(get_value<details::ProgressBarOption::min_progress>(),
+                        std::memory_order_relaxed);
+    max_progress_.store(get_value<details::ProgressBarOption::max_progress>(),
+                        std::memory_order_relaxed);
+    decremental_.store(get_value<details::ProgressBarOption::progress_type>() ==
+                           ProgressType::decremental,
+                       std::memory_order_relaxed);
+    min_redraw_interval_.store(
+        get_value<details::ProgressBarOption::min_redraw_interval>().count(),
+        std::memory_order_relaxed);
+  }
+
+  std::chrono::nanoseconds min_redraw_interval() const {
+    return std::chrono::nanoseconds(min_redraw_interval_.load(std::memory_order_relaxed));
+  }
+
+  // Whether the sharded progress, known to within the spread of the shards
+  // without summing them, could have reached the end
+  bool may_be_final_sharded() const {
+    const auto progress = static_cast<long long>(progress_.load(std::memory_order_relaxed)) +
+                          shards_->flushed();
+    return decremental_.load(std::memory_order_relaxed)
+               ? progress - shards_->spread() <=
+                     static_cast<long long>(min_progress_.load(std::memory_order_relaxed))
+               : progress + shards_->spread() >=
+                     static_cast<long long>(max_progress_.load(std::memory_order_relaxed));
+  }
+
+  bool is_final_progress(size_t progress) const {
+    return decremental_.load(std::memory_order_relaxed)
+               ? progress <= min_progress_.load(std::memory_order_relaxed)
+               : progress >= max_progress_.load(std::memory_order_relaxed);
+  }
+
+  // tick() and set_progress() only publish the new value; a frame is drawn
+  // unless the RenderScheduler draws this bar, MinRedrawInterval has not
+  // elapsed since the last one, or another thread is busy drawing one, in
+  // which case that thread's frame (or the next one) will show it. The final
+  // frame is never skipped.
+  void print_progress_if_due(size_t progress) {
+    if (is_final_progress(progress)) {
+      print_progress_if_changed();
+      return;
+    }
+    if (multi_progress_mode_)
+      return;
+    if (render_scheduled_) {
+      RenderScheduler::instance().notify(render_pending_);
+      return;
+    }
+    if (!throttle_.is_due(min_redraw_interval()))
+      return;
+    std::unique_lock<std::mutex> lock{mutex_, std::try_to_lock};
+    if (lock.owns_lock())
+      draw_progress(false, true);
+  }
+
   void save_start_time() {
     auto &show_elapsed_time =
         get_value<details::ProgressBarOption::show_elapsed_time>();
@@ -216,25 +379,76 @@ private:
     }
   }
 
-  std::pair<std::string, int> get_prefix_text() {
-    std::stringstream os;
-    os << get_value<details::ProgressBarOption::prefix_text>();
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+  std::chrono::nanoseconds remaining_time(size_t progress) const {
+    const auto max_progress =
+        get_value<details::ProgressBarOption::max_progress>();
+    auto eta = std::chrono::nanoseconds(
+        progress > 0 ? static_cast<long long>(std::ceil(
+                           float(elapsed_.count()) * max_progress / progress))
+                     : 0);
+    return eta > elapsed_ ? (eta - elapsed_) : (elapsed_ - eta);
+  }
+
+  details::VisibleState visible_state(size_t progress) const {
+    const auto max_progress =
+        get_value<details::ProgressBarOption::max_progress>();
+    const auto saved_start_time =
+        get_value<details::ProgressBarOption::saved_start_time>();
+    const auto percentage = double(progress) / double(max_progress) * 100.0f;
+
+    details::VisibleState state;
+    state.cells = static_cast<size_t>(
+        float(percentage) *
+        get_value<details::ProgressBarOption::bar_width>() / 100.0);
+    if (get_value<details::ProgressBarOption::show_percentage>())
+      state.percentage = (std::min)(
+          static_cast<size_t>(static_cast<float>(progress) / max_progress * 100),
+          size_t(100));
+    if (get_value<details::ProgressBarOption::show_elapsed_time>() &&
+        saved_start_time)
+      state.elapsed_seconds =
+          std::chrono::duration_cast<std::chrono::seconds>(elapsed_).count();
+    if (get_value<details::ProgressBarOption::show_remaining_time>() &&
+        saved_start_time)
+      state.remaining_seconds =
+          std::chrono::duration_cast<std::chrono::seconds>(
+              remaining_time(progress))
+              .count();
+    state.settings_version = settings_version_;
+    state.completed = completed_ || is_final_progress(progress);
+    return state;
+  }
+
+  // Whether the line last drawn for MultiProgress no longer shows the current
+  // state, so that it only redraws the bars that changed
+  bool changed_since_drawn() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    save_start_time();
+    if (!completed_)
+      elapsed_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::high_resolution_clock::now() - start_time_point_);
+    return visible_state(load_progress()) != last_state_;
+  }
+
+  // Appends the prefix text to frame_ and returns its display width
+  int write_prefix_text() {
+    const auto &prefix_text = get_value<details::ProgressBarOption::prefix_text>();
+    frame_ << prefix_text;
+    return text_widths_.prefix.get(prefix_text);
   }
 
-  std::pair<std::string, int> get_postfix_text() {
-    std::stringstream os;
+  // Appends the postfix text to frame_ and returns its display width
+  int write_postfix_text(size_t progress) {
+    auto &os = frame_;
+    const auto begin = os.size();
     const auto max_progress =
         get_value<details::ProgressBarOption::max_progress>();
 
     if (get_value<details::ProgressBarOption::show_percentage>()) {
-      os << " "
-         << (std::min)(static_cast<size_t>(static_cast<float>(progress_) /
-                                         max_progress * 100),
-                     size_t(100))
-         << "%";
+      os << ' ';
+      details::write_percentage(
+          os, (std::min)(static_cast<float>(progress) / max_progress * 100,
+                         100.0f));
     }
 
     auto &saved_start_time =
@@ -255,13 +469,7 @@ private:
         os << " [";
 
       if (saved_start_time) {
-        auto eta = std::chrono::nanoseconds(
-            progress_ > 0
-                ? static_cast<long long>(std::ceil(float(elapsed_.count()) *
-                                                   max_progress / progress_))
-                : 0);
-        auto remaining = eta > elapsed_ ? (eta - elapsed_) : (elapsed_ - eta);
-        details::write_duration(os, remaining);
+        details::write_duration(os, remaining_time(progress));
       } else {
         os << "00:00s";
       }
@@ -272,89 +480,130 @@ private:
         os << "]";
     }
 
-    os << " " << get_value<details::ProgressBarOption::postfix_text>();
+    os << ' ';
 
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+    // Everything written so far is ASCII, one column per byte
+    const auto &postfix_text = get_value<details::ProgressBarOption::postfix_text>();
+    const auto postfix_width = text_widths_.postfix.get(postfix_text);
+    const int result_size =
+        postfix_width == -1 ? -1 : int(os.size() - begin) + postfix_width;
+    os << postfix_text;
+    return result_size;
   }
 
-public:
-  void print_progress(bool from_multi_progress = false) {
-    std::lock_guard<std::mutex> lock{mutex_};
-
+  // Skips the frame if_changed and it would look the same as the last one.
+  // Updates skip it; MultiProgress, which has moved the cursor onto this
+  // line, and explicit calls to print_progress() always draw.
+  void draw_progress(bool from_multi_progress, bool if_changed = false) {
     auto &os = get_value<details::ProgressBarOption::stream>();
 
-    const auto type = get_value<details::ProgressBarOption::progress_type>();
-    const auto min_progress =
-        get_value<details::ProgressBarOption::min_progress>();
+    const auto progress = load_progress();
     const auto max_progress =
         get_value<details::ProgressBarOption::max_progress>();
     if (multi_progress_mode_ && !from_multi_progress) {
-      if ((type == ProgressType::incremental && progress_ >= max_progress) ||
-          (type == ProgressType::decremental && progress_ <= min_progress)) {
-        get_value<details::ProgressBarOption::completed>() = true;
+      if (is_final_progress(progress)) {
+        completed_ = true;
       }
       return;
     }
+    save_start_time();
     auto now = std::chrono::high_resolution_clock::now();
-    if (!get_value<details::ProgressBarOption::completed>())
+    if (!completed_)
       elapsed_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
           now - start_time_point_);
 
-    if (get_value<details::ProgressBarOption::foreground_color>() !=
-        Color::unspecified)
-      details::set_stream_color(
-          os, get_value<details::ProgressBarOption::foreground_color>());
-
-    for (auto &style : get_value<details::ProgressBarOption::font_styles>())
-      details::set_font_style(os, style);
-
-    const auto prefix_pair = get_prefix_text();
-    const auto prefix_text = prefix_pair.first;
-    const auto prefix_length = prefix_pair.second;
-    os << "\r" << prefix_text;
-
-    os << get_value<details::ProgressBarOption::start>();
+    const auto state = visible_state(progress);
+    if (if_changed && state == last_state_)
+      return;
+    last_state_ = state;
 
-    details::ProgressScaleWriter writer{
-        os, get_value<details::ProgressBarOption::bar_width>(),
-        get_value<details::ProgressBarOption::fill>(),
-        get_value<details::ProgressBarOption::lead>(),
-        get_value<details::ProgressBarOption::remainder>()};
-    writer.write(double(progress_) / double(max_progress) * 100.0f);
+    frame_.clear();
+    if (style_stale_) {
+      style_.assign(get_value<details::ProgressBarOption::foreground_color>(),
+                    get_value<details::ProgressBarOption::font_styles>());
+      style_stale_ = false;
+    }
+    style_.write(frame_, os);
+    frame_ << '\r';
+    const auto prefix_length = write_prefix_text();
+
+    frame_ << get_value<details::ProgressBarOption::start>();
+
+    if (scale_stale_) {
+      scale_.assign(get_value<details::ProgressBarOption::bar_width>(),
+                    get_value<details::ProgressBarOption::fill>(),
+                    get_value<details::ProgressBarOption::lead>(),
+                    get_value<details::ProgressBarOption::remainder>());
+      scale_stale_ = false;
+    }
+    details::ProgressScaleWriter writer{frame_, scale_};
+    writer.write(double(progress) / double(max_progress) * 100.0f);
 
-    os << get_value<details::ProgressBarOption::end>();
+    frame_ << get_value<details::ProgressBarOption::end>();
 
-    const auto postfix_pair = get_postfix_text();
-    const auto postfix_text = postfix_pair.first;
-    const auto postfix_length = postfix_pair.second;
-    os << postfix_text;
+    const auto postfix_length = write_postfix_text(progress);
 
     // Get length of prefix text and postfix text
-    const auto start_length = get_value<details::ProgressBarOption::start>().size();
+    const auto start_length =
+        text_widths_.start.get(get_value<details::ProgressBarOption::start>());
     const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
-    const auto end_length = get_value<details::ProgressBarOption::end>().size();
-    const auto terminal_width = terminal_size().second;
-    // prefix + bar_width + postfix should be <= terminal_width
-    const int remaining = terminal_width - (prefix_length + start_length + bar_width + end_length + postfix_length);
-    if (prefix_length == -1 || postfix_length == -1) {
-      os << "\r";
+    const auto end_length = text_widths_.end.get(get_value<details::ProgressBarOption::end>());
+    const auto terminal_width = terminal_size(os).second;
+    // prefix + bar_width + postfix should be <= terminal_width; a stream that
+    // is not a terminal has no line to pad
+    const int remaining =
+        terminal_width > 0
+            ? int(terminal_width) - int(prefix_length + start_length + bar_width + end_length +
+                                        postfix_length)
+            : 0;
+    if (prefix_length == -1 || postfix_length == -1 || start_length == -1 ||
+        end_length == -1) {
+      frame_ << '\r';
     } else if (remaining > 0) {
-      os << std::string(remaining, ' ') << "\r";
+      frame_.append(remaining, ' ') << '\r';
     } else if (remaining < 0) {
       // Do nothing. Maybe in the future truncate postfix with ...
     }
-    os.flush();
+    throttle_.redrawn();
 
-    if ((type == ProgressType::incremental && progress_ >= max_progress) ||
-        (type == ProgressType::decremental && progress_ <= min_progress)) {
-      get_value<details::ProgressBarOption::completed>() = true;
+    if (is_final_progress(progress)) {
+      completed_ = true;
     }
-    if (get_value<details::ProgressBarOption::completed>() &&
-        !from_multi_progress) // Don't std::endl if calling from MultiProgress
+    // MultiProgress and DynamicProgress write frame_ along with the lines of
+    // their other bars, and end the lines themselves
+    if (from_multi_progress)
+      return;
+    frame_.write_to(os);
+    os.flush();
+    if (completed_)
       os << termcolor::reset << std::endl;
   }
+
+  // Draws a frame for an update, unless it would look the same as the last
+  // one
+  void print_progress_if_changed() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(false, true);
+  }
+
+  // Draws this bar's line into frame without writing it, for MultiProgress
+  // and DynamicProgress, which write the lines of all their bars at once
+  void append_line(details::FrameBuffer &frame) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(true);
+    frame.append(frame_.data(), frame_.size());
+  }
+
+public:
+  void print_progress(bool from_multi_progress = false) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(from_multi_progress);
+    if (from_multi_progress) {
+      auto &os = get_value<details::ProgressBarOption::stream>();
+      frame_.write_to(os);
+      os.flush();
+    }
+  }
 };
 
 } // namespace indicators
@@ -2,6 +2,8 @@
 #ifndef INDICATORS_PROGRESS_SPINNER
 #define INDICATORS_PROGRESS_SPINNER
 
+#include <indicators/details/frame_buffer.hpp>
+#include <indicators/details/redraw_throttle.hpp>
 #include <indicators/details/stream_helper.hpp>
 
 #include <algorithm>
@@ -9,6 +11,7 @@
 #include <chrono>
 #include <cmath>
 #include <indicators/color.hpp>
+#include <indicators/render_scheduler.hpp>
 #include <indicators/setting.hpp>
 #include <iomanip>
 #include <iostream>
@@ -26,7 +29,7 @@ class ProgressSpinner {
                  option::ShowPercentage, option::ShowElapsedTime, option::ShowRemainingTime,
                  option::ShowSpinner, option::SavedStartTime, option::Completed,
                  option::MaxPostfixTextLen, option::SpinnerStates, option::FontStyles,
-                 option::MaxProgress, option::Stream>;
+                 option::MaxProgress, option::Stream, option::MinRedrawInterval>;
 
 public:
   template <typename... Args,
@@ -64,7 +67,15 @@ public:
             details::get<details::ProgressBarOption::max_progress>(option::MaxProgress{100},
                                                                    std::forward<Args>(args)...),
             details::get<details::ProgressBarOption::stream>(option::Stream{std::cout},
-                                                             std::forward<Args>(args)...)) {}
+                                                             std::forward<Args>(args)...),
+            details::get<details::ProgressBarOption::min_redraw_interval>(
+                option::MinRedrawInterval{std::chrono::nanoseconds::zero()},
+                std::forward<Args>(args)...)) {}
+
+  ~ProgressSpinner() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
 
   template <typename T, details::ProgressBarOption id>
   void set_option(details::Setting<T, id> &&setting) {
@@ -73,6 +84,8 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = std::move(setting).value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -82,6 +95,8 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = setting.value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
   }
 
   void set_option(
@@ -109,16 +124,19 @@ public:
       progress_ = value;
     }
     save_start_time();
-    print_progress();
+    print_progress_if_due(value);
   }
 
-  void tick() {
+  void tick() { advance(1); }
+
+  void advance(size_t n) {
+    size_t value;
     {
       std::lock_guard<std::mutex> lock{mutex_};
-      progress_ += 1;
+      value = progress_ += n;
     }
     save_start_time();
-    print_progress();
+    print_progress_if_due(value);
   }
 
   size_t current() {
@@ -139,6 +157,16 @@ private:
   size_t index_{0};
   std::chrono::time_point<std::chrono::high_resolution_clock> start_time_point_;
   std::mutex mutex_;
+  details::RedrawThrottle throttle_;
+  details::FrameBuffer frame_;
+  // Rebuilt before the next frame whenever set_option() changes the colour
+  // or font styles
+  details::StylePrefix style_;
+  bool style_stale_{true};
+
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
 
   template <details::ProgressBarOption id>
   auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value)) {
@@ -151,6 +179,21 @@ private:
     return details::get_value<id>(settings_).value;
   }
 
+  // Frames arriving faster than MinRedrawInterval are skipped, and frames of a
+  // spinner attached to the RenderScheduler are left to it; the frame that
+  // reaches MaxProgress is always drawn.
+  void print_progress_if_due(size_t value) {
+    if (value < get_value<details::ProgressBarOption::max_progress>()) {
+      if (render_scheduled_) {
+        RenderScheduler::instance().notify(render_pending_);
+        return;
+      }
+      if (!throttle_.is_due(get_value<details::ProgressBarOption::min_redraw_interval>()))
+        return;
+    }
+    print_progress();
+  }
+
   void save_start_time() {
     auto &show_elapsed_time = get_value<details::ProgressBarOption::show_elapsed_time>();
     auto &show_remaining_time = get_value<details::ProgressBarOption::show_remaining_time>();
@@ -171,48 +214,52 @@ public:
     auto now = std::chrono::high_resolution_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_point_);
 
-    if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
-      details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
-
-    for (auto &style : get_value<details::ProgressBarOption::font_styles>())
-      details::set_font_style(os, style);
-
-    os << get_value<details::ProgressBarOption::prefix_text>();
+    frame_.clear();
+    if (style_stale_) {
+      style_.assign(get_value<details::ProgressBarOption::foreground_color>(),
+                    get_value<details::ProgressBarOption::font_styles>());
+      style_stale_ = false;
+    }
+    style_.write(frame_, os);
+    frame_ << get_value<details::ProgressBarOption::prefix_text>();
     if (get_value<details::ProgressBarOption::spinner_show>())
-      os << get_value<details::ProgressBarOption::spinner_states>()
+      frame_ << get_value<details::ProgressBarOption::spinner_states>()
               [index_ % get_value<details::ProgressBarOption::spinner_states>().size()];
     if (get_value<details::ProgressBarOption::show_percentage>()) {
-      os << " " << std::size_t(progress_ / double(max_progress) * 100) << "%";
+      frame_ << ' ';
+      details::write_percentage(frame_, progress_ / double(max_progress) * 100);
     }
 
     if (get_value<details::ProgressBarOption::show_elapsed_time>()) {
-      os << " [";
-      details::write_duration(os, elapsed);
+      frame_ << " [";
+      details::write_duration(frame_, elapsed);
     }
 
     if (get_value<details::ProgressBarOption::show_remaining_time>()) {
       if (get_value<details::ProgressBarOption::show_elapsed_time>())
-        os << "<";
+        frame_ << "<";
       else
-        os << " [";
+        frame_ << " [";
       auto eta = std::chrono::nanoseconds(
           progress_ > 0
               ? static_cast<long long>(std::ceil(float(elapsed.count()) *
                                                  max_progress / progress_))
               : 0);
       auto remaining = eta > elapsed ? (eta - elapsed) : (elapsed - eta);
-      details::write_duration(os, remaining);
-      os << "]";
+      details::write_duration(frame_, remaining);
+      frame_ << "]";
     } else {
       if (get_value<details::ProgressBarOption::show_elapsed_time>())
-        os << "]";
+        frame_ << "]";
     }
 
     if (get_value<details::ProgressBarOption::max_postfix_text_len>() == 0)
       get_value<details::ProgressBarOption::max_postfix_text_len>() = 10;
-    os << " " << get_value<details::ProgressBarOption::postfix_text>()
-       << std::string(get_value<details::ProgressBarOption::max_postfix_text_len>(), ' ') << "\r";
+    frame_ << " " << get_value<details::ProgressBarOption::postfix_text>();
+    frame_.append(get_value<details::ProgressBarOption::max_postfix_text_len>(), ' ') << "\r";
+    frame_.write_to(os);
     os.flush();
+    throttle_.redrawn();
     index_ += 1;
     if (progress_ > max_progress) {
       get_value<details::ProgressBarOption::completed>() = true;
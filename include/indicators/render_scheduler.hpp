@@ -0,0 +1,150 @@
+
+#ifndef INDICATORS_RENDER_SCHEDULER
+#define INDICATORS_RENDER_SCHEDULER
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace indicators {
+
+// A single background thread that draws attached indicators at a fixed frame
+// rate. Once attached, tick() and friends only update counters and notify the
+// scheduler; formatting and terminal I/O move off the calling thread. Each
+// frame draws only the indicators that changed, and the thread sleeps until
+// something does, so idle indicators cost nothing. Frames that complete an
+// indicator are still drawn by the thread that completes it, so they are
+// never lost at exit.
+class RenderScheduler {
+public:
+  static RenderScheduler &instance() {
+    static RenderScheduler scheduler;
+    return scheduler;
+  }
+
+  RenderScheduler(const RenderScheduler &) = delete;
+  RenderScheduler &operator=(const RenderScheduler &) = delete;
+
+  ~RenderScheduler() {
+    {
+      std::lock_guard<std::mutex> lock{wake_mutex_};
+      stop_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable())
+      thread_.join();
+
+    // Indicators that outlive the scheduler go back to drawing themselves
+    std::lock_guard<std::mutex> lock{indicators_mutex_};
+    for (auto &entry : indicators_)
+      *entry.scheduled = false;
+  }
+
+  void set_frame_rate(size_t frames_per_second) {
+    frame_interval_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::seconds(1))
+                          .count() /
+                      static_cast<long long>((std::max)(frames_per_second, size_t(1)));
+  }
+
+  template <typename Indicator> void attach(Indicator &indicator) {
+    {
+      std::lock_guard<std::mutex> lock{indicators_mutex_};
+      indicators_.push_back(Entry{&indicator, &indicator.render_scheduled_,
+                                  &indicator.render_pending_,
+                                  [&indicator]() { draw(indicator, 0); }});
+      indicator.render_scheduled_ = true;
+      if (!thread_.joinable())
+        thread_ = std::thread(&RenderScheduler::run, this);
+    }
+    notify(indicator.render_pending_);
+  }
+
+  template <typename Indicator> void detach(Indicator &indicator) {
+    std::lock_guard<std::mutex> lock{indicators_mutex_};
+    indicator.render_scheduled_ = false;
+    indicators_.erase(std::remove_if(indicators_.begin(), indicators_.end(),
+                                     [&indicator](const Entry &entry) {
+                                       return entry.indicator == &indicator;
+                                     }),
+                      indicators_.end());
+  }
+
+  // Called by attached indicators whenever their state changes. Only the
+  // first change after the indicator was last drawn takes the lock to wake
+  // the thread.
+  void notify(std::atomic<bool> &indicator_pending) {
+    if (indicator_pending.exchange(true) || pending_.exchange(true))
+      return;
+    std::lock_guard<std::mutex> lock{wake_mutex_};
+    wake_.notify_one();
+  }
+
+private:
+  RenderScheduler() = default;
+
+  // Draws a frame for the changes of an indicator, skipping it if the
+  // indicator can tell that it would look the same as the last one
+  template <typename Indicator>
+  static auto draw(Indicator &indicator, int)
+      -> decltype(indicator.print_progress_if_changed()) {
+    indicator.print_progress_if_changed();
+  }
+  template <typename Indicator> static void draw(Indicator &indicator, long) {
+    indicator.print_progress();
+  }
+
+  struct Entry {
+    const void *indicator;
+    std::atomic<bool> *scheduled;
+    std::atomic<bool> *pending;
+    std::function<void()> print_progress;
+  };
+
+  void run() {
+    std::unique_lock<std::mutex> lock{wake_mutex_};
+    while (true) {
+      wake_.wait(lock, [this] { return stop_ || pending_; });
+      if (stop_)
+        break;
+      const auto next_frame = std::chrono::steady_clock::now() +
+                              std::chrono::nanoseconds(frame_interval_.load());
+      pending_ = false;
+      lock.unlock();
+      print_progress();
+      lock.lock();
+      // Changes arriving before the next frame is due are drawn together
+      wake_.wait_until(lock, next_frame, [this] { return stop_; });
+    }
+    lock.unlock();
+    if (pending_)
+      print_progress();
+  }
+
+  void print_progress() {
+    std::lock_guard<std::mutex> lock{indicators_mutex_};
+    for (auto &entry : indicators_)
+      if (entry.pending->exchange(false))
+        entry.print_progress();
+  }
+
+  std::mutex indicators_mutex_;
+  std::vector<Entry> indicators_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  bool stop_{false};
+  std::atomic<bool> pending_{false};
+  std::atomic<long long> frame_interval_{1000000000LL / 30};
+  std::thread thread_;
+};
+
+} // namespace indicators
+
+#endif
@@ -28,6 +28,7 @@ SOFTWARE.
 #ifndef INDICATORS_SETTING
 #define INDICATORS_SETTING
 
+#include <chrono>
 #include <cstddef>
 #include <indicators/color.hpp>
 #include <indicators/font_style.hpp>
@@ -97,7 +98,10 @@ enum class ProgressBarOption {
   min_progress,
   max_progress,
   progress_type,
-  stream
+  stream,
+  min_redraw_interval,
+  sharded_progress,
+  fit_to_terminal
 };
 
 template <typename T, ProgressBarOption Id> struct Setting {
@@ -216,6 +220,10 @@ using MinProgress = details::IntegerSetting<details::ProgressBarOption::min_prog
 using MaxProgress = details::IntegerSetting<details::ProgressBarOption::max_progress>;
 using ProgressType = details::Setting<ProgressType, details::ProgressBarOption::progress_type>;
 using Stream = details::Setting<std::ostream &, details::ProgressBarOption::stream>;
+using MinRedrawInterval =
+    details::Setting<std::chrono::nanoseconds, details::ProgressBarOption::min_redraw_interval>;
+using ShardedProgress = details::BooleanSetting<details::ProgressBarOption::sharded_progress>;
+using FitToTerminal = details::BooleanSetting<details::ProgressBarOption::fit_to_terminal>;
 } // namespace option
 } // namespace indicators
 
@@ -15,6 +15,8 @@
 #include <iostream>
 #include <cstdio>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 // Detect target's platform and set some macros in order to wrap platform
 // specific code this library depends on.
@@ -58,8 +60,10 @@ namespace termcolor
     namespace _internal
     {
         inline int colorize_index();
+        inline int colorize_decision_index();
         inline FILE* get_standard_stream(const std::ostream& stream);
         inline bool is_colorized(std::ostream& stream);
+        inline bool detect_colorize(const std::ostream& stream);
         inline bool is_atty(const std::ostream& stream);
 
     #if defined(TERMCOLOR_TARGET_WINDOWS)
@@ -81,6 +85,16 @@ namespace termcolor
         return stream;
     }
 
+    //! Forgets whether a stream was found to support colors, so that the
+    //! next manipulator checks the environment and the terminal again, e.g.
+    //! after NO_COLOR has been changed or stdout has been redirected.
+    inline
+    std::ostream& redetect_colorize(std::ostream& stream)
+    {
+        stream.iword(_internal::colorize_decision_index()) = 0L;
+        return stream;
+    }
+
     inline
     std::ostream& reset(std::ostream& stream)
     {
@@ -796,6 +810,16 @@ namespace termcolor
             return colorize_index;
         }
 
+        // An index of the private storage that remembers, for streams not
+        // marked with colorize, what detect_colorize() decided: 0 if it has
+        // not been asked yet, 1 for colors and 2 for none. This way the
+        // environment and isatty() are only consulted once per stream.
+        inline int colorize_decision_index()
+        {
+            static int colorize_decision_index = std::ios_base::xalloc();
+            return colorize_decision_index;
+        }
+
         //! Since C++ hasn't a true way to extract stream handler
         //! from the a given `std::ostream` object, I have to write
         //! this kind of hack.
@@ -811,12 +835,40 @@ namespace termcolor
         }
 
         // Say whether a given stream should be colorized or not. It's always
-        // true for ATTY streams and may be true for streams marked with
-        // colorize flag.
+        // true for streams marked with colorize flag; for others it's decided
+        // once by detect_colorize() and cached until redetect_colorize.
         inline
         bool is_colorized(std::ostream& stream)
         {
-            return is_atty(stream) || static_cast<bool>(stream.iword(colorize_index()));
+            if (stream.iword(colorize_index()))
+                return true;
+            long& decision = stream.iword(colorize_decision_index());
+            if (decision == 0L)
+                decision = detect_colorize(stream) ? 1L : 2L;
+            return decision == 1L;
+        }
+
+        // Say whether a stream not marked with colorize flag should get
+        // colors: never if NO_COLOR is set, always for a standard stream if
+        // CLICOLOR_FORCE is set to anything but 0, never if TERM is dumb,
+        // and otherwise only if it's a terminal.
+        inline
+        bool detect_colorize(const std::ostream& stream)
+        {
+            const char* no_color = std::getenv("NO_COLOR");
+            if (no_color && no_color[0] != '\0')
+                return false;
+
+            const char* force = std::getenv("CLICOLOR_FORCE");
+            if (force && force[0] != '\0' && std::strcmp(force, "0") != 0 &&
+                get_standard_stream(stream))
+                return true;
+
+            const char* term = std::getenv("TERM");
+            if (term && std::strcmp(term, "dumb") == 0)
+                return false;
+
+            return is_atty(stream);
         }
 
         //! Test whether a given `std::ostream` object refers to
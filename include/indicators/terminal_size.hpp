@@ -1,6 +1,7 @@
 
 #ifndef INDICATORS_TERMINAL_SIZE
 #define INDICATORS_TERMINAL_SIZE
+#include <iostream>
 #include <utility>
 
 
@@ -20,10 +21,32 @@ static inline std::pair<size_t, size_t> terminal_size() {
 
 static inline size_t terminal_width() { return terminal_size().second; }
 
+// Rows and columns of the console that os writes to, or {0, 0} if os does not
+// write to a console
+static inline std::pair<size_t, size_t> terminal_size(std::ostream &os) {
+  DWORD handle;
+  if (&os == &std::cout)
+    handle = STD_OUTPUT_HANDLE;
+  else if (&os == &std::cerr || &os == &std::clog)
+    handle = STD_ERROR_HANDLE;
+  else
+    return {0, 0};
+  CONSOLE_SCREEN_BUFFER_INFO csbi;
+  if (!GetConsoleScreenBufferInfo(GetStdHandle(handle), &csbi))
+    return {0, 0};
+  return {static_cast<size_t>(csbi.srWindow.Bottom - csbi.srWindow.Top + 1),
+          static_cast<size_t>(csbi.srWindow.Right - csbi.srWindow.Left + 1)};
+}
+
+// Console sizes are not cached on Windows, so there is nothing to refresh
+static inline void refresh_terminal_size() {}
+
 } // namespace indicators
 
 #else
 
+#include <atomic>
+#include <signal.h>
 #include <sys/ioctl.h> //ioctl() and TIOCGWINSZ
 #include <unistd.h>    // for STDOUT_FILENO
 
@@ -37,8 +60,109 @@ static inline std::pair<size_t, size_t> terminal_size() {
 
 static inline size_t terminal_width() { return terminal_size().second; }
 
+namespace details {
+
+// Moves on whenever the terminal is resized, telling the cached sizes below
+// to query the terminal again
+inline std::atomic<unsigned> &terminal_resize_generation() {
+  static std::atomic<unsigned> generation{0};
+  return generation;
+}
+
+inline struct sigaction &previous_resize_action() {
+  static struct sigaction action;
+  return action;
+}
+
+inline void on_terminal_resize(int signal, siginfo_t *info, void *context) {
+  terminal_resize_generation().fetch_add(1, std::memory_order_relaxed);
+  // Whoever handled SIGWINCH before us still gets to see it
+  const struct sigaction &previous = previous_resize_action();
+  if (previous.sa_flags & SA_SIGINFO) {
+    if (previous.sa_sigaction)
+      previous.sa_sigaction(signal, info, context);
+  } else if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN) {
+    previous.sa_handler(signal);
+  }
+}
+
+// Installs the SIGWINCH handler once. Returns false if it could not be
+// installed, in which case sizes must not be cached.
+inline bool watch_terminal_resizes() {
+  static const bool watching = [] {
+    struct sigaction action {};
+    sigemptyset(&action.sa_mask);
+    action.sa_sigaction = on_terminal_resize;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    return sigaction(SIGWINCH, &action, &previous_resize_action()) == 0;
+  }();
+  return watching;
+}
+
+// The size of the terminal behind one file descriptor, packed into a single
+// atomic so that bars on different threads can share it without a lock:
+// columns in bits 0-15, rows in bits 16-31, whether it is a terminal in bit
+// 32, and the resize generation it was queried in (plus one, so that zero
+// means never queried) from bit 33.
+class TerminalSizeCache {
+public:
+  std::pair<size_t, size_t> get(int fd) {
+    if (!watch_terminal_resizes())
+      return query(fd).second;
+    const auto stamp = static_cast<unsigned long long>(
+        (terminal_resize_generation().load(std::memory_order_relaxed) & 0x3fffffffu) + 1);
+    auto packed = packed_.load(std::memory_order_relaxed);
+    if ((packed >> 33) != stamp) {
+      const auto terminal = query(fd);
+      const auto &size = terminal.second;
+      packed = (stamp << 33) | (static_cast<unsigned long long>(terminal.first) << 32) |
+               ((size.first & 0xffff) << 16) | (size.second & 0xffff);
+      packed_.store(packed, std::memory_order_relaxed);
+    }
+    if (!(packed & (1ull << 32)))
+      return {0, 0};
+    return {static_cast<size_t>((packed >> 16) & 0xffff), static_cast<size_t>(packed & 0xffff)};
+  }
+
+private:
+  // Whether fd is a terminal, and if so its rows and columns
+  static std::pair<bool, std::pair<size_t, size_t>> query(int fd) {
+    struct winsize size{};
+    if (!::isatty(fd) || ioctl(fd, TIOCGWINSZ, &size) != 0)
+      return {false, {0, 0}};
+    return {true, {static_cast<size_t>(size.ws_row), static_cast<size_t>(size.ws_col)}};
+  }
+
+  std::atomic<unsigned long long> packed_{0};
+};
+
+inline TerminalSizeCache &terminal_size_cache(int fd) {
+  static TerminalSizeCache caches[3];
+  return caches[fd];
+}
+
+} // namespace details
+
+// Rows and columns of the terminal that os writes to, or {0, 0} if os is not
+// a terminal: a file, a string stream, or std::cout redirected to a pipe.
+// The size is queried once and then again only after the terminal has been
+// resized.
+static inline std::pair<size_t, size_t> terminal_size(std::ostream &os) {
+  if (&os == &std::cout)
+    return details::terminal_size_cache(STDOUT_FILENO).get(STDOUT_FILENO);
+  if (&os == &std::cerr || &os == &std::clog)
+    return details::terminal_size_cache(STDERR_FILENO).get(STDERR_FILENO);
+  return {0, 0};
+}
+
+// Makes the next terminal_size(os) query the terminal again. Only needed by
+// programs that replace the SIGWINCH handler without calling the previous one.
+static inline void refresh_terminal_size() {
+  details::terminal_resize_generation().fetch_add(1, std::memory_order_relaxed);
+}
+
 } // namespace indicators
 
 #endif
 
-#endif
\ No newline at end of file
+#endif
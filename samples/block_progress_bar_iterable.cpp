@@ -17,7 +17,8 @@ int main() {
   using namespace indicators;
   BlockProgressBar bar{option::BarWidth{80}, option::ForegroundColor{Color::white},
                        option::FontStyles{std::vector<FontStyle>{FontStyle::bold}},
-                       option::MaxProgress{numbers.size()}};
+                       option::MaxProgress{numbers.size()},
+                       option::MinRedrawInterval{std::chrono::milliseconds(50)}};
 
   std::cout << "Iterating over a list of numbers (size = " << numbers.size() << ")\n";
 
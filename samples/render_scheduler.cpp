@@ -0,0 +1,42 @@
+#include <indicators/block_progress_bar.hpp>
+#include <indicators/cursor_control.hpp>
+#include <indicators/render_scheduler.hpp>
+#include <thread>
+#include <vector>
+
+int main() {
+  using namespace indicators;
+
+  // Hide cursor
+  show_console_cursor(false);
+
+  BlockProgressBar bar{option::BarWidth{80}, option::ForegroundColor{Color::green},
+                       option::FontStyles{std::vector<FontStyle>{FontStyle::bold}},
+                       option::ShowElapsedTime{true}, option::MaxProgress{4 * 50000}};
+
+  // The workers below only bump the counter; drawing happens at 20 frames
+  // per second on the scheduler's own thread
+  RenderScheduler::instance().set_frame_rate(20);
+  RenderScheduler::instance().attach(bar);
+
+  auto job = [&bar]() {
+    for (size_t i = 0; i < 50000; ++i) {
+      bar.tick();
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < 4; ++i)
+    workers.emplace_back(job);
+  for (auto &worker : workers)
+    worker.join();
+
+  bar.mark_as_completed();
+  RenderScheduler::instance().detach(bar);
+
+  // Show cursor
+  show_console_cursor(true);
+
+  return 0;
+}
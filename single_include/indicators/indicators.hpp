@@ -47,6 +47,8 @@ enum class ProgressType { incremental, decremental };
 #include <iostream>
 #include <cstdio>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 // Detect target's platform and set some macros in order to wrap platform
 // specific code this library depends on.
@@ -90,8 +92,10 @@ namespace termcolor
     namespace _internal
     {
         inline int colorize_index();
+        inline int colorize_decision_index();
         inline FILE* get_standard_stream(const std::ostream& stream);
         inline bool is_colorized(std::ostream& stream);
+        inline bool detect_colorize(const std::ostream& stream);
         inline bool is_atty(const std::ostream& stream);
 
     #if defined(TERMCOLOR_TARGET_WINDOWS)
@@ -113,6 +117,16 @@ namespace termcolor
         return stream;
     }
 
+    //! Forgets whether a stream was found to support colors, so that the
+    //! next manipulator checks the environment and the terminal again, e.g.
+    //! after NO_COLOR has been changed or stdout has been redirected.
+    inline
+    std::ostream& redetect_colorize(std::ostream& stream)
+    {
+        stream.iword(_internal::colorize_decision_index()) = 0L;
+        return stream;
+    }
+
     inline
     std::ostream& reset(std::ostream& stream)
     {
@@ -828,6 +842,16 @@ namespace termcolor
             return colorize_index;
         }
 
+        // An index of the private storage that remembers, for streams not
+        // marked with colorize, what detect_colorize() decided: 0 if it has
+        // not been asked yet, 1 for colors and 2 for none. This way the
+        // environment and isatty() are only consulted once per stream.
+        inline int colorize_decision_index()
+        {
+            static int colorize_decision_index = std::ios_base::xalloc();
+            return colorize_decision_index;
+        }
+
         //! Since C++ hasn't a true way to extract stream handler
         //! from the a given `std::ostream` object, I have to write
         //! this kind of hack.
@@ -843,12 +867,40 @@ namespace termcolor
         }
 
         // Say whether a given stream should be colorized or not. It's always
-        // true for ATTY streams and may be true for streams marked with
-        // colorize flag.
+        // true for streams marked with colorize flag; for others it's decided
+        // once by detect_colorize() and cached until redetect_colorize.
         inline
         bool is_colorized(std::ostream& stream)
         {
-            return is_atty(stream) || static_cast<bool>(stream.iword(colorize_index()));
+            if (stream.iword(colorize_index()))
+                return true;
+            long& decision = stream.iword(colorize_decision_index());
+            if (decision == 0L)
+                decision = detect_colorize(stream) ? 1L : 2L;
+            return decision == 1L;
+        }
+
+        // Say whether a stream not marked with colorize flag should get
+        // colors: never if NO_COLOR is set, always for a standard stream if
+        // CLICOLOR_FORCE is set to anything but 0, never if TERM is dumb,
+        // and otherwise only if it's a terminal.
+        inline
+        bool detect_colorize(const std::ostream& stream)
+        {
+            const char* no_color = std::getenv("NO_COLOR");
+            if (no_color && no_color[0] != '\0')
+                return false;
+
+            const char* force = std::getenv("CLICOLOR_FORCE");
+            if (force && force[0] != '\0' && std::strcmp(force, "0") != 0 &&
+                get_standard_stream(stream))
+                return true;
+
+            const char* term = std::getenv("TERM");
+            if (term && std::strcmp(term, "dumb") == 0)
+                return false;
+
+            return is_atty(stream);
         }
 
         //! Test whether a given `std::ostream` object refers to
@@ -952,6 +1004,7 @@ namespace termcolor
 
 #ifndef INDICATORS_TERMINAL_SIZE
 #define INDICATORS_TERMINAL_SIZE
+#include <iostream>
 #include <utility>
 
 
@@ -971,10 +1024,32 @@ static inline std::pair<size_t, size_t> terminal_size() {
 
 static inline size_t terminal_width() { return terminal_size().second; }
 
+// Rows and columns of the console that os writes to, or {0, 0} if os does not
+// write to a console
+static inline std::pair<size_t, size_t> terminal_size(std::ostream &os) {
+  DWORD handle;
+  if (&os == &std::cout)
+    handle = STD_OUTPUT_HANDLE;
+  else if (&os == &std::cerr || &os == &std::clog)
+    handle = STD_ERROR_HANDLE;
+  else
+    return {0, 0};
+  CONSOLE_SCREEN_BUFFER_INFO csbi;
+  if (!GetConsoleScreenBufferInfo(GetStdHandle(handle), &csbi))
+    return {0, 0};
+  return {static_cast<size_t>(csbi.srWindow.Bottom - csbi.srWindow.Top + 1),
+          static_cast<size_t>(csbi.srWindow.Right - csbi.srWindow.Left + 1)};
+}
+
+// Console sizes are not cached on Windows, so there is nothing to refresh
+static inline void refresh_terminal_size() {}
+
 } // namespace indicators
 
 #else
 
+#include <atomic>
+#include <signal.h>
 #include <sys/ioctl.h> //ioctl() and TIOCGWINSZ
 #include <unistd.h>    // for STDOUT_FILENO
 
@@ -988,6 +1063,107 @@ static inline std::pair<size_t, size_t> terminal_size() {
 
 static inline size_t terminal_width() { return terminal_size().second; }
 
+namespace details {
+
+// Moves on whenever the terminal is resized, telling the cached sizes below
+// to query the terminal again
+inline std::atomic<unsigned> &terminal_resize_generation() {
+  static std::atomic<unsigned> generation{0};
+  return generation;
+}
+
+inline struct sigaction &previous_resize_action() {
+  static struct sigaction action;
+  return action;
+}
+
+inline void on_terminal_resize(int signal, siginfo_t *info, void *context) {
+  terminal_resize_generation().fetch_add(1, std::memory_order_relaxed);
+  // Whoever handled SIGWINCH before us still gets to see it
+  const struct sigaction &previous = previous_resize_action();
+  if (previous.sa_flags & SA_SIGINFO) {
+    if (previous.sa_sigaction)
+      previous.sa_sigaction(signal, info, context);
+  } else if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN) {
+    previous.sa_handler(signal);
+  }
+}
+
+// Installs the SIGWINCH handler once. Returns false if it could not be
+// installed, in which case sizes must not be cached.
+inline bool watch_terminal_resizes() {
+  static const bool watching = [] {
+    struct sigaction action {};
+    sigemptyset(&action.sa_mask);
+    action.sa_sigaction = on_terminal_resize;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    return sigaction(SIGWINCH, &action, &previous_resize_action()) == 0;
+  }();
+  return watching;
+}
+
+// The size of the terminal behind one file descriptor, packed into a single
+// atomic so that bars on different threads can share it without a lock:
+// columns in bits 0-15, rows in bits 16-31, whether it is a terminal in bit
+// 32, and the resize generation it was queried in (plus one, so that zero
+// means never queried) from bit 33.
+class TerminalSizeCache {
+public:
+  std::pair<size_t, size_t> get(int fd) {
+    if (!watch_terminal_resizes())
+      return query(fd).second;
+    const auto stamp = static_cast<unsigned long long>(
+        (terminal_resize_generation().load(std::memory_order_relaxed) & 0x3fffffffu) + 1);
+    auto packed = packed_.load(std::memory_order_relaxed);
+    if ((packed >> 33) != stamp) {
+      const auto terminal = query(fd);
+      const auto &size = terminal.second;
+      packed = (stamp << 33) | (static_cast<unsigned long long>(terminal.first) << 32) |
+               ((size.first & 0xffff) << 16) | (size.second & 0xffff);
+      packed_.store(packed, std::memory_order_relaxed);
+    }
+    if (!(packed & (1ull << 32)))
+      return {0, 0};
+    return {static_cast<size_t>((packed >> 16) & 0xffff), static_cast<size_t>(packed & 0xffff)};
+  }
+
+private:
+  // Whether fd is a terminal, and if so its rows and columns
+  static std::pair<bool, std::pair<size_t, size_t>> query(int fd) {
+    struct winsize size{};
+    if (!::isatty(fd) || ioctl(fd, TIOCGWINSZ, &size) != 0)
+      return {false, {0, 0}};
+    return {true, {static_cast<size_t>(size.ws_row), static_cast<size_t>(size.ws_col)}};
+  }
+
+  std::atomic<unsigned long long> packed_{0};
+};
+
+inline TerminalSizeCache &terminal_size_cache(int fd) {
+  static TerminalSizeCache caches[3];
+  return caches[fd];
+}
+
+} // namespace details
+
+// Rows and columns of the terminal that os writes to, or {0, 0} if os is not
+// a terminal: a file, a string stream, or std::cout redirected to a pipe.
+// The size is queried once and then again only after the terminal has been
+// resized.
+static inline std::pair<size_t, size_t> terminal_size(std::ostream &os) {
+  if (&os == &std::cout)
+    return details::terminal_size_cache(STDOUT_FILENO).get(STDOUT_FILENO);
+  if (&os == &std::cerr || &os == &std::clog)
+    return details::terminal_size_cache(STDERR_FILENO).get(STDERR_FILENO);
+  return {0, 0};
+}
+
+// Makes the next terminal_size(os) query the terminal again. Only needed by
+// programs that replace the SIGWINCH handler without calling the previous one.
+static inline void refresh_terminal_size() {
+  details::terminal_resize_generation().fetch_add(1, std::memory_order_relaxed);
+}
+
 } // namespace indicators
 
 #endif
@@ -995,6 +1171,7 @@ static inline size_t terminal_width() { return terminal_size().second; }
 #endif
 
 
+
 /*
 Activity Indicators for Modern C++
 https://github.com/p-ranav/indicators
@@ -1024,6 +1201,7 @@ SOFTWARE.
 #ifndef INDICATORS_SETTING
 #define INDICATORS_SETTING
 
+#include <chrono>
 #include <cstddef>
 // #include <indicators/color.hpp>
 // #include <indicators/font_style.hpp>
@@ -1093,7 +1271,10 @@ enum class ProgressBarOption {
   min_progress,
   max_progress,
   progress_type,
-  stream
+  stream,
+  min_redraw_interval,
+  sharded_progress,
+  fit_to_terminal
 };
 
 template <typename T, ProgressBarOption Id> struct Setting {
@@ -1212,6 +1393,10 @@ using MinProgress = details::IntegerSetting<details::ProgressBarOption::min_prog
 using MaxProgress = details::IntegerSetting<details::ProgressBarOption::max_progress>;
 using ProgressType = details::Setting<ProgressType, details::ProgressBarOption::progress_type>;
 using Stream = details::Setting<std::ostream &, details::ProgressBarOption::stream>;
+using MinRedrawInterval =
+    details::Setting<std::chrono::nanoseconds, details::ProgressBarOption::min_redraw_interval>;
+using ShardedProgress = details::BooleanSetting<details::ProgressBarOption::sharded_progress>;
+using FitToTerminal = details::BooleanSetting<details::ProgressBarOption::fit_to_terminal>;
 } // namespace option
 } // namespace indicators
 
@@ -1318,7 +1503,7 @@ static inline void move(int x, int y) {
 }
 
 static inline void move_up(int lines) { move(0, -lines); }
-static inline void move_down(int lines) { move(0, -lines); }
+static inline void move_down(int lines) { move(0, lines); }
 static inline void move_right(int cols) { move(cols, 0); }
 static inline void move_left(int cols) { move(-cols, 0); }
 
@@ -1339,15 +1524,1260 @@ static inline void move_left(int cols) { std::cout << "\033[" << cols << "D"; }
 #ifndef INDICATORS_STREAM_HELPER
 #define INDICATORS_STREAM_HELPER
 
+// #include <indicators/details/frame_buffer.hpp>
+#ifndef INDICATORS_FRAME_BUFFER
+#define INDICATORS_FRAME_BUFFER
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace indicators {
+namespace details {
+
+// The text of one frame, assembled in memory and handed to the stream with a
+// single write(). The storage is kept between frames, so once it has grown to
+// the length of a line, drawing a frame no longer allocates.
+class FrameBuffer {
+public:
+  void clear() { buffer_.clear(); }
+
+  const char *data() const { return buffer_.data(); }
+  size_t size() const { return buffer_.size(); }
+
+  FrameBuffer &append(const char *text, size_t length) {
+    buffer_.append(text, length);
+    return *this;
+  }
+
+  FrameBuffer &append(size_t count, char c) {
+    buffer_.append(count, c);
+    return *this;
+  }
+
+  FrameBuffer &operator<<(const std::string &text) {
+    buffer_.append(text);
+    return *this;
+  }
+
+  FrameBuffer &operator<<(const char *text) {
+    buffer_.append(text, std::strlen(text));
+    return *this;
+  }
+
+  FrameBuffer &operator<<(char c) {
+    buffer_.push_back(c);
+    return *this;
+  }
+
+  void write_to(std::ostream &os) const {
+    os.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  }
+
+private:
+  std::string buffer_;
+};
+
+} // namespace details
+} // namespace indicators
+
+#endif
+
+// #include <indicators/details/number_format.hpp>
+#ifndef INDICATORS_NUMBER_FORMAT
+#define INDICATORS_NUMBER_FORMAT
+
+// #include <indicators/details/frame_buffer.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace indicators {
+namespace details {
+
+// Formats numbers straight into a FrameBuffer, two digits at a time, without
+// going through iostreams or touching the heap.
+
+inline const char *digit_pairs() {
+  static constexpr char pairs[] = "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899";
+  return pairs;
+}
+
+// Writes the decimal digits of value into the 20 characters that precede end,
+// right-aligned, and returns a pointer to the first digit
+inline char *format_unsigned(unsigned long long value, char *end) {
+  const char *pairs = digit_pairs();
+  char *first = end;
+  while (value >= 100) {
+    first -= 2;
+    std::memcpy(first, pairs + (value % 100) * 2, 2);
+    value /= 100;
+  }
+  if (value >= 10) {
+    first -= 2;
+    std::memcpy(first, pairs + value * 2, 2);
+  } else {
+    *--first = char('0' + value);
+  }
+  return first;
+}
+
+// Writes value in decimal, left-padded with zeros to at least min_digits
+inline FrameBuffer &write_unsigned(FrameBuffer &os, unsigned long long value,
+                                   size_t min_digits = 1) {
+  char digits[20];
+  const char *first = format_unsigned(value, digits + sizeof(digits));
+  const size_t count = size_t(digits + sizeof(digits) - first);
+  if (count < min_digits)
+    os.append(min_digits - count, '0');
+  return os.append(first, count);
+}
+
+// Writes value in decimal with separator between groups of three digits,
+// e.g. 1,234,567
+inline FrameBuffer &write_count(FrameBuffer &os, unsigned long long value, char separator = ',') {
+  char digits[20];
+  const char *first = format_unsigned(value, digits + sizeof(digits));
+  const char *last = digits + sizeof(digits);
+  char grouped[26];
+  char *out = grouped;
+  size_t group = size_t(last - first) % 3 == 0 ? 3 : size_t(last - first) % 3;
+  for (;;) {
+    std::memcpy(out, first, group);
+    out += group;
+    first += group;
+    if (first == last)
+      break;
+    *out++ = separator;
+    group = 3;
+  }
+  return os.append(grouped, size_t(out - grouped));
+}
+
+inline unsigned long long power_of_ten(unsigned exponent) {
+  static constexpr unsigned long long powers[] = {1ull,        10ull,        100ull,
+                                                  1000ull,     10000ull,     100000ull,
+                                                  1000000ull,  10000000ull,  100000000ull,
+                                                  1000000000ull};
+  return powers[exponent];
+}
+
+// Writes value with exactly decimals (at most 9) digits after the point. With
+// truncate, the digits beyond are dropped instead of rounded, so that 99.96
+// with one decimal reads 99.9 rather than 100.0.
+inline FrameBuffer &write_fixed(FrameBuffer &os, double value, unsigned decimals,
+                                bool truncate = false) {
+  if (std::isnan(value))
+    return os << "nan";
+  if (value < 0) {
+    os << '-';
+    value = -value;
+  }
+  if (decimals > 9)
+    decimals = 9;
+  const auto scale = power_of_ten(decimals);
+  const double scaled = truncate ? std::floor(value * scale) : std::floor(value * scale + 0.5);
+  if (!(scaled < 1e19))
+    return os << "inf";
+  const auto units = static_cast<unsigned long long>(scaled);
+  write_unsigned(os, units / scale);
+  if (decimals > 0) {
+    os << '.';
+    write_unsigned(os, units % scale, decimals);
+  }
+  return os;
+}
+
+// Writes a percentage such as 42% or 42.5%. Digits beyond decimals are
+// truncated, so an unfinished task never reads 100%.
+inline FrameBuffer &write_percentage(FrameBuffer &os, double percentage, unsigned decimals = 0) {
+  return write_fixed(os, percentage, decimals, true) << '%';
+}
+
+// Writes a rate such as 1234.5/s
+inline FrameBuffer &write_rate(FrameBuffer &os, double per_second, unsigned decimals = 1) {
+  return write_fixed(os, per_second, decimals) << "/s";
+}
+
+// Writes a duration as [dd"d:"][hh"h:"]mm"m:"ss"s", leaving out the days and
+// hours while they are zero
+inline FrameBuffer &write_duration(FrameBuffer &os, std::chrono::nanoseconds ns) {
+  using namespace std::chrono;
+  if (ns.count() < 0)
+    ns = nanoseconds::zero();
+  using days = duration<int, std::ratio<86400>>;
+  auto d = duration_cast<days>(ns);
+  ns -= d;
+  auto h = duration_cast<hours>(ns);
+  ns -= h;
+  auto m = duration_cast<minutes>(ns);
+  ns -= m;
+  auto s = duration_cast<seconds>(ns);
+  if (d.count() > 0)
+    write_unsigned(os, static_cast<unsigned long long>(d.count()), 2) << "d:";
+  if (h.count() > 0)
+    write_unsigned(os, static_cast<unsigned long long>(h.count()), 2) << "h:";
+  write_unsigned(os, static_cast<unsigned long long>(m.count()), 2) << "m:";
+  write_unsigned(os, static_cast<unsigned long long>(s.count()), 2) << 's';
+  return os;
+}
+
+} // namespace details
+} // namespace indicators
+
+#endif
+
 // #include <indicators/display_width.hpp>
 #ifndef INDICATORS_DISPLAY_WIDTH
 #define INDICATORS_DISPLAY_WIDTH
 
-#include <clocale>
-#include <cstdlib>
-#include <locale>
+// #include <indicators/details/width_table.hpp>
+// Generated by utils/width_table/generate_width_table.py from Unicode
+// 16.0.0 -- do not edit.
+
+#ifndef INDICATORS_WIDTH_TABLE
+#define INDICATORS_WIDTH_TABLE
+
+namespace unicode {
+
+namespace details {
+
+// Two-bit width class of every code point (0 zero width, 1 narrow, 2 wide,
+// 3 East Asian Ambiguous), four to a byte in leaves of 256 code points.
+// pages[ucs >> 8] is the index of the leaf that holds ucs. Defined in a
+// class template so that every translation unit shares one copy. 11648 bytes.
+template <typename = void> struct width_table {
+  static constexpr unsigned char pages[4352] = {
+      0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+      0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x12, 0x12, 0x12, 0x14,
+      0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x12, 0x12, 0x1b, 0x1c, 0x1d, 0x1e,
+      0x1f, 0x20, 0x21, 0x22, 0x12, 0x12, 0x12, 0x23, 0x24, 0x25, 0x26, 0x27,
+      0x28, 0x29, 0x2a, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2c, 0x12, 0x2d, 0x12,
+      0x2e, 0x2f, 0x30, 0x31, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x32,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x2b, 0x2b, 0x34,
+      0x12, 0x12, 0x35, 0x36, 0x12, 0x37, 0x38, 0x39, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x3a, 0x12, 0x12, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0x40, 0x41,
+      0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x12, 0x49, 0x4a, 0x4b, 0x4c,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x4d, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x4e, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x4f, 0x50, 0x12, 0x12, 0x12, 0x51, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x52, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x53, 0x54, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x55,
+      0x2b, 0x56, 0x57, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x58, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x59, 0x12, 0x5a, 0x5b, 0x5c,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x5d, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x5e, 0x50, 0x5f, 0x12, 0x60, 0x61, 0x12, 0x12, 0x62, 0x63, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b,
+      0x12, 0x6c, 0x6d, 0x12, 0x12, 0x12, 0x12, 0x12, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x6e,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b,
+      0x2b, 0x2b, 0x2b, 0x6e, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x6f, 0x70, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x71, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+      0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x71,
+  };
+  static constexpr unsigned char leaves[7296] = {
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x5d, 0xd7, 0x77, 0x7d, 0xff, 0xf7, 0x7f, 0xff,
+      0x55, 0x75, 0x55, 0x55, 0x57, 0xd5, 0x57, 0xf5, 0x5f, 0x75, 0x7f, 0x5f,
+      0xf7, 0xd5, 0x7f, 0x77, 0x5d, 0x55, 0x55, 0x55, 0xdd, 0x55, 0xd5, 0x55,
+      0x55, 0xf5, 0xd5, 0x55, 0xfd, 0x55, 0x57, 0xd5, 0x7f, 0x57, 0xff, 0x5d,
+      0xf5, 0x55, 0x55, 0x55, 0x55, 0xf5, 0xd5, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x75, 0x77, 0x77, 0x77, 0x57,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x5d, 0x55, 0x55, 0x55, 0x5d, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xd7, 0xfd, 0x5d,
+      0x57, 0x55, 0xff, 0xdd, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xfd, 0xff, 0xff, 0xff, 0xdf, 0xff, 0x5f, 0x55, 0xfd, 0xff, 0xff, 0xff,
+      0xdf, 0xff, 0x5f, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x5d, 0x55, 0x55, 0x55, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0x5d, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x15, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x41, 0x10, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x00, 0x50, 0x55, 0x55, 0x00, 0x00, 0x40, 0x54, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x10, 0x00, 0x14, 0x04, 0x50,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x51, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00,
+      0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x15, 0x00, 0x00, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x05, 0x10, 0x00, 0x00, 0x01, 0x01, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x15, 0x00, 0x00,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x45, 0x54, 0x01, 0x00, 0x54, 0x51, 0x01, 0x00, 0x55, 0x55,
+      0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54,
+      0x01, 0x54, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x45, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54, 0x41, 0x15, 0x14, 0x50,
+      0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x51, 0x55, 0x55,
+      0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x54, 0x01, 0x10, 0x54, 0x51, 0x55, 0x55, 0x55, 0x55,
+      0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x51, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14,
+      0x01, 0x54, 0x55, 0x51, 0x55, 0x41, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x51,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x54, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x04, 0x54, 0x05, 0x04, 0x50, 0x55, 0x41, 0x55, 0x55,
+      0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14,
+      0x55, 0x45, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x01, 0x54, 0x55, 0x51,
+      0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x05, 0x44, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x00, 0x40, 0x55,
+      0x55, 0x15, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x51, 0x00, 0x00, 0x54, 0x55, 0x55, 0x00, 0x40,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x11, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x40, 0x00, 0x04, 0x55, 0x01,
+      0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54,
+      0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x01, 0x04, 0x00, 0x41, 0x41, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x50, 0x05, 0x54, 0x55, 0x55, 0x55, 0x01, 0x54, 0x55, 0x55,
+      0x45, 0x41, 0x55, 0x51, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x05, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x10, 0x00, 0x50, 0x55, 0x45, 0x01, 0x00,
+      0x00, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x15, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x40, 0x15, 0x54, 0x55, 0x45, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x15, 0x14, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x00, 0x40, 0x44, 0x01, 0x00, 0x54,
+      0x15, 0x00, 0x00, 0x14, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x04, 0x40, 0x54, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x15, 0x00, 0x00, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x10, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x50, 0x11,
+      0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x00, 0x00, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x00, 0x00, 0x00,
+      0x04, 0x00, 0x54, 0x51, 0x55, 0x54, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x55, 0x55, 0x15, 0x00, 0xd7, 0x7f, 0x5f, 0x5f, 0x7f, 0xff, 0x05, 0x40,
+      0xf7, 0x5d, 0xd5, 0x75, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x00, 0x04, 0x00, 0x00, 0x55, 0x57, 0x55, 0xd5, 0xfd, 0x57, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x57, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x54, 0x55, 0x55, 0x55, 0xd5, 0x5d, 0x5d, 0x55, 0xd5, 0x75, 0x55, 0x55,
+      0x7d, 0x75, 0xd5, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xd5, 0x57, 0xd5, 0x7f, 0xff, 0xff, 0xff, 0x55, 0xff, 0xff, 0x5f, 0x55,
+      0x55, 0x55, 0x5d, 0x55, 0xff, 0xff, 0x5f, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x5f, 0x55, 0x55, 0x55, 0x55, 0x55, 0x75, 0x57, 0x55, 0x55,
+      0x55, 0xd5, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xf7, 0xd5, 0xd7, 0xd5,
+      0x5d, 0x5d, 0x75, 0xfd, 0xd7, 0xdd, 0xff, 0x77, 0x55, 0xff, 0x55, 0x5f,
+      0x55, 0x55, 0x57, 0x57, 0x75, 0x55, 0x55, 0x55, 0x5f, 0xff, 0xf5, 0xf5,
+      0x55, 0x55, 0x55, 0x55, 0xf5, 0xf5, 0x55, 0x55, 0x55, 0x5d, 0x5d, 0x55,
+      0x55, 0x5d, 0x55, 0x55, 0x55, 0x55, 0x55, 0xd5, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x75, 0x55, 0xa5, 0x55, 0x55, 0x55, 0x69, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xa9, 0x56,
+      0x96, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0x55, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0x55, 0x55, 0x55, 0xff, 0xff, 0xff, 0xff, 0xf5, 0x5f, 0x55, 0x55,
+      0xdf, 0xff, 0x5f, 0x55, 0xf5, 0xf5, 0x55, 0x5f, 0x5f, 0xf5, 0xd7, 0xf5,
+      0x5f, 0x55, 0x55, 0x55, 0xf5, 0x5f, 0x55, 0xd5, 0x55, 0x55, 0x55, 0x69,
+      0x55, 0x7d, 0x5d, 0xf5, 0x55, 0x5a, 0x55, 0x77, 0x55, 0x55, 0x55, 0x55,
+      0xaa, 0xaa, 0x55, 0x55, 0x77, 0x55, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55,
+      0xdf, 0xdf, 0x7f, 0xdf, 0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0xa5, 0xaa,
+      0x95, 0x55, 0x55, 0xf5, 0x59, 0x55, 0xa5, 0x55, 0x55, 0x55, 0x55, 0xe9,
+      0x55, 0xfa, 0xff, 0xef, 0xff, 0xfe, 0xff, 0xff, 0xdf, 0x55, 0xef, 0xff,
+      0xaf, 0xfb, 0xef, 0xfb, 0x55, 0x59, 0xa5, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x5d, 0x55, 0x55, 0x55, 0x66,
+      0x95, 0x9a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xf5, 0xff, 0xff,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0xa9, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x56, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x95, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x56, 0xf9, 0x5f, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x9a, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0x0a, 0xa0, 0xaa, 0xaa, 0xaa, 0x6a, 0xa9, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x81, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0xa9, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xa9, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a, 0x55, 0x95, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xff, 0xff, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x15, 0x40, 0x00, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x50, 0x55, 0x55, 0x55, 0x45, 0x45, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x41, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x00, 0x00, 0x00, 0x00, 0x50, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x15, 0x00, 0x00, 0x50, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0x56, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x15, 0x05, 0x50, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x40,
+      0x41, 0x41, 0x55, 0x55, 0x15, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x14, 0x54, 0x05,
+      0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50,
+      0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x51, 0x54, 0x51, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+      0xaa, 0xaa, 0x5a, 0x55, 0x00, 0x00, 0x00, 0x00, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0xa9, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x6a, 0x55, 0x55,
+      0x55, 0x55, 0x01, 0x5d, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x01, 0x41, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x15, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x50,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00,
+      0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x05, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00,
+      0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x14, 0x54, 0x55, 0x15, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x15, 0x40, 0x41, 0x51, 0x45, 0x55, 0x55, 0x51,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x01,
+      0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x40,
+      0x55, 0x55, 0x01, 0x14, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x15, 0x50, 0x04, 0x55, 0x45, 0x51, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0x15, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54,
+      0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x54,
+      0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x54, 0x55, 0x55, 0x45,
+      0x44, 0x55, 0x55, 0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x00, 0x00, 0x05, 0x44, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x44, 0x15,
+      0x04, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x05, 0x50, 0x55, 0x10, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x40, 0x11,
+      0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x15, 0x51, 0x00, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x11, 0x05, 0x10, 0x00, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x44,
+      0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x00, 0x05, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x01, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x15, 0x00, 0x14, 0x40, 0x55, 0x15, 0x55, 0x55, 0x01, 0x40, 0x01, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00,
+      0x00, 0x40, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x00, 0x10, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00,
+      0x04, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x40, 0x45, 0x10,
+      0x00, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x11, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x15, 0x54, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x40, 0x55, 0x44, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+      0x54, 0x15, 0x00, 0x00, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x50, 0x01,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+      0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x54, 0x55, 0x55,
+      0x5a, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95,
+      0xaa, 0xaa, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0xaa, 0xa9, 0xaa, 0x69, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x55, 0x55, 0x55, 0x65, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x6a, 0x59, 0x55, 0x55, 0x55, 0xaa, 0x55, 0x55,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x00, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x15, 0x50, 0x55, 0x15, 0x00, 0x00, 0x00, 0x40, 0x01, 0x00, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x54, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0x6a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x40, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x54, 0x55, 0x51, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55,
+      0x55, 0x55, 0x15, 0x00, 0x01, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00,
+      0x10, 0x04, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xff, 0xff, 0x7f, 0x55,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5f, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5f, 0x55,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xab, 0xaa, 0xea, 0xff,
+      0xff, 0xff, 0xff, 0x57, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0xa5, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0x6a, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0x55, 0xaa, 0xaa, 0x56, 0x55, 0x5a, 0x55, 0x55, 0x55,
+      0xaa, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0x56, 0x55, 0x55, 0xa9, 0xaa, 0x9a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xa6,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x95, 0xaa, 0x55, 0x55, 0x55,
+      0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0x56, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a,
+      0xa6, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x96,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0x5a, 0x55, 0x55, 0x95, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x65, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x69, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x95, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a, 0x55, 0x56, 0x6a, 0xa9, 0x55, 0xaa,
+      0x55, 0x55, 0x95, 0x56, 0x55, 0xaa, 0xaa, 0x56, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0x55, 0x56, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0x9a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0x56,
+      0xaa, 0xaa, 0x5a, 0x95, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x55, 0xa5, 0xaa, 0xaa, 0xaa, 0x96,
+      0xaa, 0xaa, 0x5a, 0x55, 0xaa, 0xaa, 0x56, 0x55, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+      0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a,
+      0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+      0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5f,
+  };
+};
+
+template <typename T> constexpr unsigned char width_table<T>::pages[];
+template <typename T> constexpr unsigned char width_table<T>::leaves[];
+
+// Width class of ucs; code points beyond U+10FFFF are narrow
+constexpr int width_class(char32_t ucs) {
+  return ucs > 0x10ffff ? 1
+                        : (width_table<>::leaves[width_table<>::pages[ucs >> 8] * 64 +
+                                                 (ucs & 0xff) / 4] >>
+                           (ucs % 4 * 2)) &
+                              3;
+}
+
+} // namespace details
+
+} // namespace unicode
+
+#endif
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
-#include <wchar.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INDICATORS_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// From C++17 on, the decoding and width rules below are constexpr, so that
+// indicators::literal_width() can measure string literals at compile time
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define INDICATORS_CONSTEXPR_WIDTH constexpr
+#define INDICATORS_HAS_LITERAL_WIDTH
+#else
+#define INDICATORS_CONSTEXPR_WIDTH
+#endif
 
 namespace unicode {
 
@@ -1414,31 +2844,6 @@ namespace details {
  * Latest version: http://www.cl.cam.ac.uk/~mgk25/ucs/wcwidth.c
  */
 
-struct interval {
-  int first;
-  int last;
-};
-
-/* auxiliary function for binary search in interval table */
-static inline int bisearch(wchar_t ucs, const struct interval *table, int max) {
-  int min = 0;
-  int mid;
-
-  if (ucs < table[0].first || ucs > table[max].last)
-    return 0;
-  while (max >= min) {
-    mid = (min + max) / 2;
-    if (ucs > table[mid].last)
-      min = mid + 1;
-    else if (ucs < table[mid].first)
-      max = mid - 1;
-    else
-      return 1;
-  }
-
-  return 0;
-}
-
 /* The following two functions define the column width of an ISO 10646
  * character as follows:
  *
@@ -1456,100 +2861,38 @@ static inline int bisearch(wchar_t ucs, const struct interval *table, int max) {
  *    - Other format characters (general category code Cf in the Unicode
  *      database) and ZERO WIDTH SPACE (U+200B) have a column width of 0.
  *
- *    - Hangul Jamo medial vowels and final consonants (U+1160-U+11FF)
- *      have a column width of 0.
+ *    - Hangul Jamo medial vowels and final consonants (U+1160-U+11FF,
+ *      U+D7B0-U+D7FF) have a column width of 0.
  *
  *    - Spacing characters in the East Asian Wide (W) or East Asian
  *      Full-width (F) category as defined in Unicode Technical
- *      Report #11 have a column width of 2.
+ *      Report #11 have a column width of 2. So do regional indicators
+ *      (U+1F1E6-U+1F1FF), which are drawn in pairs as one flag.
  *
  *    - All remaining characters (including all printable
  *      ISO 8859-1 and WGL4 characters, Unicode control characters,
  *      etc.) have a column width of 1.
  *
  * This implementation assumes that wchar_t characters are encoded
- * in ISO 10646.
+ * in ISO 10646. Code points are taken as char32_t, so that characters
+ * beyond the BMP keep their width where wchar_t is 16 bits wide.
+ *
+ * Unlike the original, the categories come from the Unicode release
+ * named at the top of details/width_table.hpp, not from Unicode 5.0.
  */
 
-static inline int mk_wcwidth(wchar_t ucs) {
-  /* sorted list of non-overlapping intervals of non-spacing characters */
-  /* generated by "uniset +cat=Me +cat=Mn +cat=Cf -00AD +1160-11FF +200B c" */
-  static const struct interval combining[] = {
-      {0x0300, 0x036F},   {0x0483, 0x0486},   {0x0488, 0x0489},
-      {0x0591, 0x05BD},   {0x05BF, 0x05BF},   {0x05C1, 0x05C2},
-      {0x05C4, 0x05C5},   {0x05C7, 0x05C7},   {0x0600, 0x0603},
-      {0x0610, 0x0615},   {0x064B, 0x065E},   {0x0670, 0x0670},
-      {0x06D6, 0x06E4},   {0x06E7, 0x06E8},   {0x06EA, 0x06ED},
-      {0x070F, 0x070F},   {0x0711, 0x0711},   {0x0730, 0x074A},
-      {0x07A6, 0x07B0},   {0x07EB, 0x07F3},   {0x0901, 0x0902},
-      {0x093C, 0x093C},   {0x0941, 0x0948},   {0x094D, 0x094D},
-      {0x0951, 0x0954},   {0x0962, 0x0963},   {0x0981, 0x0981},
-      {0x09BC, 0x09BC},   {0x09C1, 0x09C4},   {0x09CD, 0x09CD},
-      {0x09E2, 0x09E3},   {0x0A01, 0x0A02},   {0x0A3C, 0x0A3C},
-      {0x0A41, 0x0A42},   {0x0A47, 0x0A48},   {0x0A4B, 0x0A4D},
-      {0x0A70, 0x0A71},   {0x0A81, 0x0A82},   {0x0ABC, 0x0ABC},
-      {0x0AC1, 0x0AC5},   {0x0AC7, 0x0AC8},   {0x0ACD, 0x0ACD},
-      {0x0AE2, 0x0AE3},   {0x0B01, 0x0B01},   {0x0B3C, 0x0B3C},
-      {0x0B3F, 0x0B3F},   {0x0B41, 0x0B43},   {0x0B4D, 0x0B4D},
-      {0x0B56, 0x0B56},   {0x0B82, 0x0B82},   {0x0BC0, 0x0BC0},
-      {0x0BCD, 0x0BCD},   {0x0C3E, 0x0C40},   {0x0C46, 0x0C48},
-      {0x0C4A, 0x0C4D},   {0x0C55, 0x0C56},   {0x0CBC, 0x0CBC},
-      {0x0CBF, 0x0CBF},   {0x0CC6, 0x0CC6},   {0x0CCC, 0x0CCD},
-      {0x0CE2, 0x0CE3},   {0x0D41, 0x0D43},   {0x0D4D, 0x0D4D},
-      {0x0DCA, 0x0DCA},   {0x0DD2, 0x0DD4},   {0x0DD6, 0x0DD6},
-      {0x0E31, 0x0E31},   {0x0E34, 0x0E3A},   {0x0E47, 0x0E4E},
-      {0x0EB1, 0x0EB1},   {0x0EB4, 0x0EB9},   {0x0EBB, 0x0EBC},
-      {0x0EC8, 0x0ECD},   {0x0F18, 0x0F19},   {0x0F35, 0x0F35},
-      {0x0F37, 0x0F37},   {0x0F39, 0x0F39},   {0x0F71, 0x0F7E},
-      {0x0F80, 0x0F84},   {0x0F86, 0x0F87},   {0x0F90, 0x0F97},
-      {0x0F99, 0x0FBC},   {0x0FC6, 0x0FC6},   {0x102D, 0x1030},
-      {0x1032, 0x1032},   {0x1036, 0x1037},   {0x1039, 0x1039},
-      {0x1058, 0x1059},   {0x1160, 0x11FF},   {0x135F, 0x135F},
-      {0x1712, 0x1714},   {0x1732, 0x1734},   {0x1752, 0x1753},
-      {0x1772, 0x1773},   {0x17B4, 0x17B5},   {0x17B7, 0x17BD},
-      {0x17C6, 0x17C6},   {0x17C9, 0x17D3},   {0x17DD, 0x17DD},
-      {0x180B, 0x180D},   {0x18A9, 0x18A9},   {0x1920, 0x1922},
-      {0x1927, 0x1928},   {0x1932, 0x1932},   {0x1939, 0x193B},
-      {0x1A17, 0x1A18},   {0x1B00, 0x1B03},   {0x1B34, 0x1B34},
-      {0x1B36, 0x1B3A},   {0x1B3C, 0x1B3C},   {0x1B42, 0x1B42},
-      {0x1B6B, 0x1B73},   {0x1DC0, 0x1DCA},   {0x1DFE, 0x1DFF},
-      {0x200B, 0x200F},   {0x202A, 0x202E},   {0x2060, 0x2063},
-      {0x206A, 0x206F},   {0x20D0, 0x20EF},   {0x302A, 0x302F},
-      {0x3099, 0x309A},   {0xA806, 0xA806},   {0xA80B, 0xA80B},
-      {0xA825, 0xA826},   {0xFB1E, 0xFB1E},   {0xFE00, 0xFE0F},
-      {0xFE20, 0xFE23},   {0xFEFF, 0xFEFF},   {0xFFF9, 0xFFFB},
-      {0x10A01, 0x10A03}, {0x10A05, 0x10A06}, {0x10A0C, 0x10A0F},
-      {0x10A38, 0x10A3A}, {0x10A3F, 0x10A3F}, {0x1D167, 0x1D169},
-      {0x1D173, 0x1D182}, {0x1D185, 0x1D18B}, {0x1D1AA, 0x1D1AD},
-      {0x1D242, 0x1D244}, {0xE0001, 0xE0001}, {0xE0020, 0xE007F},
-      {0xE0100, 0xE01EF}};
-
+static inline INDICATORS_CONSTEXPR_WIDTH int mk_wcwidth(char32_t ucs) {
   /* test for 8-bit control characters */
   if (ucs == 0)
     return 0;
   if (ucs < 32 || (ucs >= 0x7f && ucs < 0xa0))
     return -1;
 
-  /* binary search in table of non-spacing characters */
-  if (bisearch(ucs, combining, sizeof(combining) / sizeof(struct interval) - 1))
-    return 0;
-
-  /* if we arrive here, ucs is not a combining or C0/C1 control character */
-
-  return 1 +
-         (ucs >= 0x1100 &&
-          (ucs <= 0x115f || /* Hangul Jamo init. consonants */
-           ucs == 0x2329 || ucs == 0x232a ||
-           (ucs >= 0x2e80 && ucs <= 0xa4cf && ucs != 0x303f) || /* CJK ... Yi */
-           (ucs >= 0xac00 && ucs <= 0xd7a3) || /* Hangul Syllables */
-           (ucs >= 0xf900 &&
-            ucs <= 0xfaff) || /* CJK Compatibility Ideographs */
-           (ucs >= 0xfe10 && ucs <= 0xfe19) || /* Vertical forms */
-           (ucs >= 0xfe30 && ucs <= 0xfe6f) || /* CJK Compatibility Forms */
-           (ucs >= 0xff00 && ucs <= 0xff60) || /* Fullwidth Forms */
-           (ucs >= 0xffe0 && ucs <= 0xffe6) ||
-           (ucs >= 0x20000 && ucs <= 0x2fffd) ||
-           (ucs >= 0x30000 && ucs <= 0x3fffd)));
+  /* the widths of all other characters are looked up in the table generated
+   * by utils/width_table/generate_width_table.py, in which ambiguous
+   * characters are narrow */
+  const int width = width_class(ucs);
+  return width == 3 ? 1 : width;
 }
 
 static inline int mk_wcswidth(const wchar_t *pwcs, size_t n) {
@@ -1573,68 +2916,14 @@ static inline int mk_wcswidth(const wchar_t *pwcs, size_t n) {
  * the traditional terminal character-width behaviour. It is not
  * otherwise recommended for general use.
  */
-static inline int mk_wcwidth_cjk(wchar_t ucs) {
-  /* sorted list of non-overlapping intervals of East Asian Ambiguous
-   * characters, generated by "uniset +WIDTH-A -cat=Me -cat=Mn -cat=Cf c" */
-  static const struct interval ambiguous[] = {
-      {0x00A1, 0x00A1}, {0x00A4, 0x00A4},   {0x00A7, 0x00A8},
-      {0x00AA, 0x00AA}, {0x00AE, 0x00AE},   {0x00B0, 0x00B4},
-      {0x00B6, 0x00BA}, {0x00BC, 0x00BF},   {0x00C6, 0x00C6},
-      {0x00D0, 0x00D0}, {0x00D7, 0x00D8},   {0x00DE, 0x00E1},
-      {0x00E6, 0x00E6}, {0x00E8, 0x00EA},   {0x00EC, 0x00ED},
-      {0x00F0, 0x00F0}, {0x00F2, 0x00F3},   {0x00F7, 0x00FA},
-      {0x00FC, 0x00FC}, {0x00FE, 0x00FE},   {0x0101, 0x0101},
-      {0x0111, 0x0111}, {0x0113, 0x0113},   {0x011B, 0x011B},
-      {0x0126, 0x0127}, {0x012B, 0x012B},   {0x0131, 0x0133},
-      {0x0138, 0x0138}, {0x013F, 0x0142},   {0x0144, 0x0144},
-      {0x0148, 0x014B}, {0x014D, 0x014D},   {0x0152, 0x0153},
-      {0x0166, 0x0167}, {0x016B, 0x016B},   {0x01CE, 0x01CE},
-      {0x01D0, 0x01D0}, {0x01D2, 0x01D2},   {0x01D4, 0x01D4},
-      {0x01D6, 0x01D6}, {0x01D8, 0x01D8},   {0x01DA, 0x01DA},
-      {0x01DC, 0x01DC}, {0x0251, 0x0251},   {0x0261, 0x0261},
-      {0x02C4, 0x02C4}, {0x02C7, 0x02C7},   {0x02C9, 0x02CB},
-      {0x02CD, 0x02CD}, {0x02D0, 0x02D0},   {0x02D8, 0x02DB},
-      {0x02DD, 0x02DD}, {0x02DF, 0x02DF},   {0x0391, 0x03A1},
-      {0x03A3, 0x03A9}, {0x03B1, 0x03C1},   {0x03C3, 0x03C9},
-      {0x0401, 0x0401}, {0x0410, 0x044F},   {0x0451, 0x0451},
-      {0x2010, 0x2010}, {0x2013, 0x2016},   {0x2018, 0x2019},
-      {0x201C, 0x201D}, {0x2020, 0x2022},   {0x2024, 0x2027},
-      {0x2030, 0x2030}, {0x2032, 0x2033},   {0x2035, 0x2035},
-      {0x203B, 0x203B}, {0x203E, 0x203E},   {0x2074, 0x2074},
-      {0x207F, 0x207F}, {0x2081, 0x2084},   {0x20AC, 0x20AC},
-      {0x2103, 0x2103}, {0x2105, 0x2105},   {0x2109, 0x2109},
-      {0x2113, 0x2113}, {0x2116, 0x2116},   {0x2121, 0x2122},
-      {0x2126, 0x2126}, {0x212B, 0x212B},   {0x2153, 0x2154},
-      {0x215B, 0x215E}, {0x2160, 0x216B},   {0x2170, 0x2179},
-      {0x2190, 0x2199}, {0x21B8, 0x21B9},   {0x21D2, 0x21D2},
-      {0x21D4, 0x21D4}, {0x21E7, 0x21E7},   {0x2200, 0x2200},
-      {0x2202, 0x2203}, {0x2207, 0x2208},   {0x220B, 0x220B},
-      {0x220F, 0x220F}, {0x2211, 0x2211},   {0x2215, 0x2215},
-      {0x221A, 0x221A}, {0x221D, 0x2220},   {0x2223, 0x2223},
-      {0x2225, 0x2225}, {0x2227, 0x222C},   {0x222E, 0x222E},
-      {0x2234, 0x2237}, {0x223C, 0x223D},   {0x2248, 0x2248},
-      {0x224C, 0x224C}, {0x2252, 0x2252},   {0x2260, 0x2261},
-      {0x2264, 0x2267}, {0x226A, 0x226B},   {0x226E, 0x226F},
-      {0x2282, 0x2283}, {0x2286, 0x2287},   {0x2295, 0x2295},
-      {0x2299, 0x2299}, {0x22A5, 0x22A5},   {0x22BF, 0x22BF},
-      {0x2312, 0x2312}, {0x2460, 0x24E9},   {0x24EB, 0x254B},
-      {0x2550, 0x2573}, {0x2580, 0x258F},   {0x2592, 0x2595},
-      {0x25A0, 0x25A1}, {0x25A3, 0x25A9},   {0x25B2, 0x25B3},
-      {0x25B6, 0x25B7}, {0x25BC, 0x25BD},   {0x25C0, 0x25C1},
-      {0x25C6, 0x25C8}, {0x25CB, 0x25CB},   {0x25CE, 0x25D1},
-      {0x25E2, 0x25E5}, {0x25EF, 0x25EF},   {0x2605, 0x2606},
-      {0x2609, 0x2609}, {0x260E, 0x260F},   {0x2614, 0x2615},
-      {0x261C, 0x261C}, {0x261E, 0x261E},   {0x2640, 0x2640},
-      {0x2642, 0x2642}, {0x2660, 0x2661},   {0x2663, 0x2665},
-      {0x2667, 0x266A}, {0x266C, 0x266D},   {0x266F, 0x266F},
-      {0x273D, 0x273D}, {0x2776, 0x277F},   {0xE000, 0xF8FF},
-      {0xFFFD, 0xFFFD}, {0xF0000, 0xFFFFD}, {0x100000, 0x10FFFD}};
-
-  /* binary search in table of non-spacing characters */
-  if (bisearch(ucs, ambiguous, sizeof(ambiguous) / sizeof(struct interval) - 1))
-    return 2;
-
-  return mk_wcwidth(ucs);
+static inline int mk_wcwidth_cjk(char32_t ucs) {
+  if (ucs == 0)
+    return 0;
+  if (ucs < 32 || (ucs >= 0x7f && ucs < 0xa0))
+    return -1;
+
+  const int width = width_class(ucs);
+  return width == 3 ? 2 : width;
 }
 
 static inline int mk_wcswidth_cjk(const wchar_t *pwcs, size_t n) {
@@ -1649,54 +2938,291 @@ static inline int mk_wcswidth_cjk(const wchar_t *pwcs, size_t n) {
   return width;
 }
 
-// convert UTF-8 string to wstring
-#ifdef _MSC_VER
-static inline std::wstring utf8_decode(const std::string& s) {
-    auto r = setlocale(LC_ALL, "");
-    std::string curLocale;
-    if (r)
-      curLocale = r;
-    const char* _Source = s.c_str();
-    size_t _Dsize = std::strlen(_Source) + 1;
-    wchar_t* _Dest = new wchar_t[_Dsize];
-    size_t _Osize;
-    mbstowcs_s(&_Osize, _Dest, _Dsize, _Source, _Dsize);
-    std::wstring result = _Dest;
-    delete[] _Dest;
-    setlocale(LC_ALL, curLocale.c_str());
-    return result;
+// Measures a line fed to it one code point at a time, counting the grapheme
+// clusters that terminals draw as a single emoji once:
+//
+//  - emoji joined by ZERO WIDTH JOINER (U+200D), as in a family or a
+//    profession, are as wide as the first;
+//  - VARIATION SELECTOR-16 (U+FE0F) gives a narrow character such as U+2764
+//    HEAVY BLACK HEART its two column emoji presentation;
+//  - an emoji modifier (a skin tone) after an emoji adds no width;
+//  - two regional indicators form one flag.
+class ClusterWidth {
+public:
+  // Columns that ucs adds to the line, or -1 for a control character
+  INDICATORS_CONSTEXPR_WIDTH int next(char32_t ucs) {
+    const int width = mk_wcwidth(ucs);
+    if (width < 0)
+      return -1;
+    const bool joined = joined_;
+    joined_ = false;
+    if (ucs == 0x200d) {
+      joined_ = previous_ == 2;
+      return 0;
+    }
+    if (ucs == 0xfe0f) {
+      if (previous_ != 1)
+        return 0;
+      previous_ = 2;
+      return 1;
+    }
+    if (width == 0 || joined)
+      return 0;
+    if (ucs >= 0x1f3fb && ucs <= 0x1f3ff && previous_ == 2)
+      return 0;
+    const bool regional = ucs >= 0x1f1e6 && ucs <= 0x1f1ff;
+    if (regional && regional_) {
+      regional_ = false;
+      return 0;
+    }
+    regional_ = regional;
+    previous_ = width;
+    return width;
+  }
+
+  // Catches up with a run of printable ASCII characters that was measured
+  // without calling next()
+  void skip_ascii() {
+    previous_ = 1;
+    joined_ = false;
+    regional_ = false;
+  }
+
+private:
+  int previous_ = 0;      // width of the last character that was not zero width
+  bool joined_ = false;   // the last character was a ZWJ after an emoji
+  bool regional_ = false; // the last character was an unpaired regional indicator
+};
+
+// Decodes the UTF-8 sequence at it, and moves it past the sequence. A
+// malformed, overlong or truncated sequence decodes as U+FFFD and only the
+// first byte is skipped, so that measuring never needs the C library's
+// locale-dependent multibyte functions.
+static inline INDICATORS_CONSTEXPR_WIDTH char32_t utf8_next(const char *&it,
+                                                          const char *end) {
+  const auto lead = static_cast<unsigned char>(*it++);
+  if (lead < 0x80)
+    return lead;
+
+  int extra = 0;
+  char32_t ucs = 0;
+  if (lead >= 0xc2 && lead <= 0xdf) {
+    extra = 1;
+    ucs = lead & 0x1f;
+  } else if (lead >= 0xe0 && lead <= 0xef) {
+    extra = 2;
+    ucs = lead & 0x0f;
+  } else if (lead >= 0xf0 && lead <= 0xf4) {
+    extra = 3;
+    ucs = lead & 0x07;
+  } else {
+    return 0xfffd;
+  }
+
+  const char *next = it;
+  for (int i = 0; i < extra; ++i, ++next) {
+    if (next == end)
+      return 0xfffd;
+    const auto byte = static_cast<unsigned char>(*next);
+    if ((byte & 0xc0) != 0x80)
+      return 0xfffd;
+    ucs = (ucs << 6) | (byte & 0x3f);
+  }
+  if ((extra == 2 && ucs < 0x800) || (extra == 3 && (ucs < 0x10000 || ucs > 0x10ffff)) ||
+      (ucs >= 0xd800 && ucs <= 0xdfff))
+    return 0xfffd;
+
+  it = next;
+  return ucs;
 }
-#else 
-static inline std::wstring utf8_decode(const std::string& s) {
-    auto r = setlocale(LC_ALL, "");
-    std::string curLocale;
-    if (r)
-      curLocale = r;
-    const char* _Source = s.c_str();
-    size_t _Dsize = mbstowcs(NULL, _Source, 0) + 1;
-    wchar_t* _Dest = new wchar_t[_Dsize];
-    wmemset(_Dest, 0, _Dsize);
-    mbstowcs(_Dest, _Source, _Dsize);
-    std::wstring result = _Dest;
-    delete[] _Dest;
-    setlocale(LC_ALL, curLocale.c_str());
-    return result;
+
+// Moves past the escape sequence that starts with the ESC at it. Terminals
+// draw nothing for these, so colour codes in prefix or postfix text take no
+// columns. Recognises CSI sequences (ESC [ parameters final), OSC and the
+// other string commands (ESC ] ... terminated by BEL or ESC \), and the
+// remaining ECMA-48 escapes (ESC, intermediates, final). An unterminated
+// sequence runs to the end of the text.
+template <typename Iterator>
+INDICATORS_CONSTEXPR_WIDTH Iterator skip_escape_sequence(Iterator it, Iterator end) {
+  if (++it == end)
+    return end;
+  const auto introducer = *it++;
+  if (introducer == '[') {
+    while (it != end && !(*it >= 0x40 && *it <= 0x7e))
+      ++it;
+    return it == end ? end : it + 1;
+  }
+  if (introducer == ']' || introducer == 'P' || introducer == 'X' || introducer == '^' ||
+      introducer == '_') {
+    for (; it != end; ++it) {
+      if (*it == 0x07)
+        return it + 1;
+      if (*it == 0x1b && it + 1 != end && it[1] == '\\')
+        return it + 2;
+    }
+    return end;
+  }
+  if (introducer >= 0x20 && introducer <= 0x2f) {
+    while (it != end && *it >= 0x20 && *it <= 0x2f)
+      ++it;
+    return it == end ? end : it + 1;
+  }
+  return it;
+}
+
+static inline unsigned trailing_zeros(std::uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
 }
+
+// Length of the run of printable ASCII characters (0x20 to 0x7e), each one
+// column wide, at the start of input. Scans 32 or 16 bytes at a time when
+// compiled for AVX2 or SSE2, and 8 at a time otherwise.
+static inline size_t printable_ascii_prefix(const char *input, size_t size) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  // Bytes of 0x80 and above are negative as signed chars, so they fail the
+  // first comparison
+  const __m256i below = _mm256_set1_epi8(0x1f);
+  const __m256i above = _mm256_set1_epi8(0x7f);
+  for (; i + 32 <= size; i += 32) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i));
+    const __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, below),
+                                               _mm256_cmpgt_epi8(above, bytes));
+    const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(printable));
+    if (mask != 0xffffffffu)
+      return i + trailing_zeros(~mask);
+  }
+#elif defined(INDICATORS_SSE2)
+  const __m128i below = _mm_set1_epi8(0x1f);
+  const __m128i above = _mm_set1_epi8(0x7f);
+  for (; i + 16 <= size; i += 16) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i));
+    const __m128i printable =
+        _mm_and_si128(_mm_cmpgt_epi8(bytes, below), _mm_cmpgt_epi8(above, bytes));
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(printable));
+    if (mask != 0xffffu)
+      return i + trailing_zeros(~mask);
+  }
+#else
+  // Sets the high bit of every byte below 0x20 or above 0x7e; exact for the
+  // word as a whole, which is all that is needed to skip it
+  const std::uint64_t ones = 0x0101010101010101ull;
+  const std::uint64_t highs = 0x8080808080808080ull;
+  for (; i + 8 <= size; i += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, input + i, sizeof(word));
+    if ((((word - ones * 0x20) & ~word) | ((word + ones) | word)) & highs)
+      break;
+  }
 #endif
+  while (i < size && static_cast<unsigned char>(input[i]) - 0x20u < 0x5fu)
+    ++i;
+  return i;
+}
 
 } // namespace details
 
-static inline int display_width(const std::string &input) {
+// Column width of UTF-8 text, or -1 if it contains a control character.
+// Escape sequences such as colour codes take no columns, and emoji sequences
+// are counted as the single glyph a terminal draws for them
+// (see details::ClusterWidth). Decodes in a single pass without allocating
+// or consulting the locale, so it is safe to call from several rendering
+// threads at once.
+static inline int display_width(const char *input, size_t size) {
   using namespace unicode::details;
-  return mk_wcswidth(utf8_decode(input).c_str(), input.size());
+  ClusterWidth clusters;
+  int width = 0;
+  for (const char *it = input, *end = input + size; it != end;) {
+    if (static_cast<unsigned char>(*it) - 0x20u < 0x5fu) {
+      const auto ascii = printable_ascii_prefix(it, size_t(end - it));
+      width += static_cast<int>(ascii);
+      it += ascii;
+      clusters.skip_ascii();
+      if (it == end)
+        break;
+    }
+    if (*it == 0x1b) {
+      it = skip_escape_sequence(it, end);
+      continue;
+    }
+    const auto ucs = utf8_next(it, end);
+    // Like mk_wcswidth(), stop at the first null character
+    if (ucs == 0)
+      break;
+    const int w = clusters.next(ucs);
+    if (w < 0)
+      return -1;
+    width += w;
+  }
+  return width;
+}
+
+static inline int display_width(const std::string &input) {
+  return display_width(input.data(), input.size());
 }
 
 static inline int display_width(const std::wstring &input) {
-  return details::mk_wcswidth(input.c_str(), input.size());
+  details::ClusterWidth clusters;
+  int width = 0;
+  for (auto it = input.begin(), end = input.end(); it != end; ++it) {
+    if (*it == 0x1b) {
+      it = details::skip_escape_sequence(it, end) - 1;
+      continue;
+    }
+    auto ucs = static_cast<char32_t>(*it);
+    // Surrogate pairs, where wchar_t is 16 bits wide
+    if (ucs >= 0xd800 && ucs <= 0xdbff && it + 1 != end && it[1] >= 0xdc00 && it[1] <= 0xdfff)
+      ucs = 0x10000 + ((ucs - 0xd800) << 10) + (static_cast<char32_t>(*++it) - 0xdc00);
+    if (ucs == 0)
+      break;
+    const int w = clusters.next(ucs);
+    if (w < 0)
+      return -1;
+    width += w;
+  }
+  return width;
 }
 
 } // namespace unicode
 
+#ifdef INDICATORS_HAS_LITERAL_WIDTH
+namespace indicators {
+
+// Column width of a UTF-8 string literal, computed at compile time by the
+// same rules as unicode::display_width(), e.g.
+//
+//   static_assert(indicators::literal_width("█") == 1);
+//
+// Only available from C++17 on.
+template <size_t N> constexpr int literal_width(const char (&text)[N]) {
+  using namespace unicode::details;
+  ClusterWidth clusters;
+  int width = 0;
+  for (const char *it = text, *end = text + N - 1; it != end;) {
+    if (*it == 0x1b) {
+      it = skip_escape_sequence(it, end);
+      continue;
+    }
+    const auto ucs = utf8_next(it, end);
+    if (ucs == 0)
+      break;
+    const int w = clusters.next(ucs);
+    if (w < 0)
+      return -1;
+    width += w;
+  }
+  return width;
+}
+
+} // namespace indicators
+#endif
+
 #endif
 // #include <indicators/setting.hpp>
 // #include <indicators/termcolor.hpp>
@@ -1711,6 +3237,14 @@ static inline int display_width(const std::wstring &input) {
 #include <cassert>
 #include <cmath>
 
+// termcolor undefines the implementation it autodetected at the end of its
+// header, so its choice is repeated here
+#if defined(TERMCOLOR_USE_ANSI_ESCAPE_SEQUENCES) ||                                          \
+    (!defined(TERMCOLOR_USE_WINDOWS_API) && !defined(TERMCOLOR_USE_NOOP) && !defined(_WIN32) && \
+     !defined(_WIN64))
+#define INDICATORS_ANSI_ESCAPE_SEQUENCES
+#endif
+
 namespace indicators {
 namespace details {
 
@@ -1776,17 +3310,87 @@ inline void set_font_style(std::ostream &os, FontStyle style) {
   }
 }
 
-inline std::ostream &write_duration(std::ostream &os, std::chrono::nanoseconds ns) {
-  using namespace std;
-  using namespace std::chrono;
-  using days = duration<int, ratio<86400>>;
-  char fill = os.fill();
-  os.fill('0');
-  auto d = duration_cast<days>(ns);
-  ns -= d;
-  auto h = duration_cast<hours>(ns);
-  ns -= h;
-  auto m = duration_cast<minutes>(ns);
+// An indicator's foreground colour and font styles merged into a single SGR
+// escape sequence such as "\033[33;1m". It is built when those options change
+// and copied into each frame only if the stream is colourised. Consoles driven
+// through the Windows API cannot take escape sequences, so there the
+// termcolor manipulators are still applied to the stream.
+class StylePrefix {
+public:
+  static constexpr bool depends_on(ProgressBarOption id) {
+    return id == ProgressBarOption::foreground_color || id == ProgressBarOption::font_styles;
+  }
+
+  void assign(Color color, const std::vector<FontStyle> &styles) {
+    color_ = color;
+    styles_ = styles;
+    sgr_.clear();
+    if (color != Color::unspecified)
+      add_parameter(30 + static_cast<int>(color));
+    for (auto style : styles)
+      add_parameter(sgr_parameter(style));
+    if (!sgr_.empty())
+      sgr_ = "\033[" + sgr_ + "m";
+  }
+
+  void write(FrameBuffer &frame, std::ostream &os) const {
+#if defined(INDICATORS_ANSI_ESCAPE_SEQUENCES)
+    if (!sgr_.empty() && termcolor::_internal::is_colorized(os))
+      frame << sgr_;
+#else
+    (void)frame;
+    if (color_ != Color::unspecified)
+      set_stream_color(os, color_);
+    for (auto style : styles_)
+      set_font_style(os, style);
+#endif
+  }
+
+private:
+  static int sgr_parameter(FontStyle style) {
+    switch (style) {
+    case FontStyle::bold:
+      return 1;
+    case FontStyle::dark:
+      return 2;
+    case FontStyle::italic:
+      return 3;
+    case FontStyle::underline:
+      return 4;
+    case FontStyle::blink:
+      return 5;
+    case FontStyle::reverse:
+      return 7;
+    case FontStyle::concealed:
+      return 8;
+    case FontStyle::crossed:
+      return 9;
+    }
+    return 0;
+  }
+
+  void add_parameter(int parameter) {
+    if (!sgr_.empty())
+      sgr_ += ';';
+    sgr_ += std::to_string(parameter);
+  }
+
+  Color color_ = Color::unspecified;
+  std::vector<FontStyle> styles_;
+  std::string sgr_;
+};
+
+inline std::ostream &write_duration(std::ostream &os, std::chrono::nanoseconds ns) {
+  using namespace std;
+  using namespace std::chrono;
+  using days = duration<int, ratio<86400>>;
+  char fill = os.fill();
+  os.fill('0');
+  auto d = duration_cast<days>(ns);
+  ns -= d;
+  auto h = duration_cast<hours>(ns);
+  ns -= h;
+  auto m = duration_cast<minutes>(ns);
   ns -= m;
   auto s = duration_cast<seconds>(ns);
   if (d.count() > 0)
@@ -1800,139 +3404,620 @@ inline std::ostream &write_duration(std::ostream &os, std::chrono::nanoseconds n
 
 class BlockProgressScaleWriter {
 public:
-  BlockProgressScaleWriter(std::ostream &os, size_t bar_width) : os(os), bar_width(bar_width) {}
+  BlockProgressScaleWriter(FrameBuffer &os, size_t bar_width) : os(os), bar_width(bar_width) {}
+
+  FrameBuffer &write(float progress) {
+    // A run of full blocks that is sliced to length, and the partial blocks
+    // for each eighth of a cell
+    static constexpr const char fill_run[] =
+        "████████████████"
+        "████████████████"
+        "████████████████"
+        "████████████████";
+    static constexpr size_t fill_bytes = 3;
+    static constexpr size_t fill_run_cells = (sizeof(fill_run) - 1) / fill_bytes;
+    static constexpr const char *lead_characters[] = {" ", "▏", "▎", "▍", "▌", "▋", "▊", "▉"};
 
-  std::ostream &write(float progress) {
-    std::string fill_text{"█"};
-    std::vector<std::string> lead_characters{" ", "▏", "▎", "▍", "▌", "▋", "▊", "▉"};
     auto value = (std::min)(1.0f, (std::max)(0.0f, progress / 100.0f));
-    auto whole_width = std::floor(value * bar_width);
+    auto whole_width = size_t(std::floor(value * bar_width));
     auto remainder_width = fmod((value * bar_width), 1.0f);
-    auto part_width = std::floor(remainder_width * lead_characters.size());
-    std::string lead_text = lead_characters[size_t(part_width)];
-    if ((bar_width - whole_width - 1) < 0)
-      lead_text = "";
-    for (size_t i = 0; i < whole_width; ++i)
-      os << fill_text;
-    os << lead_text;
-    for (size_t i = 0; i < (bar_width - whole_width - 1); ++i)
-      os << " ";
+    auto part_width = size_t(std::floor(remainder_width * 8));
+    for (size_t cells = whole_width; cells > 0;) {
+      const auto slice = (std::min)(cells, fill_run_cells);
+      os.append(fill_run, slice * fill_bytes);
+      cells -= slice;
+    }
+    if (whole_width < bar_width) {
+      os << lead_characters[part_width];
+      os.append(bar_width - whole_width - 1, ' ');
+    }
     return os;
   }
 
 private:
-  std::ostream &os;
+  FrameBuffer &os;
   size_t bar_width = 0;
 };
 
-class ProgressScaleWriter {
-public:
-  ProgressScaleWriter(std::ostream &os, size_t bar_width, const std::string &fill,
-                      const std::string &lead, const std::string &remainder)
-      : os(os), bar_width(bar_width), fill(fill), lead(lead), remainder(remainder) {}
-
-  std::ostream &write(float progress) {
-    auto pos = static_cast<size_t>(progress * bar_width / 100.0);
-    for (size_t i = 0, current_display_width = 0; i < bar_width;) {
-      std::string next;
-
-      if (i < pos) {
-        next = fill;
-        current_display_width = unicode::display_width(fill);
-      } else if (i == pos) {
-        next = lead;
-        current_display_width = unicode::display_width(lead);
-      } else {
-        next = remainder;
-        current_display_width = unicode::display_width(remainder);
-      }
+// One glyph of a bar, repeated as often as it fits in the bar, so that any
+// number of copies can be written with a single append.
+struct GlyphRun {
+  std::string text;
+  size_t bytes = 0;
+  size_t width = 1;
+
+  void assign(const std::string &glyph, size_t bar_width) {
+    // Glyphs without a usable width (empty, combining or control characters)
+    // take up one cell, otherwise the bar would never fill
+    const auto glyph_width = unicode::display_width(glyph);
+    width = glyph_width > 0 ? size_t(glyph_width) : 1;
+    bytes = glyph.size();
+    text.clear();
+    for (size_t i = 0; i < bar_width / width; ++i)
+      text += glyph;
+  }
 
-      i += current_display_width;
+  void write(FrameBuffer &os, size_t count) const { os.append(text.data(), bytes * count); }
+};
 
-      if (i > bar_width) {
-        // `next` is larger than the allowed bar width
-        // fill with empty space instead
-        os << std::string((bar_width - (i - current_display_width)), ' ');
-        break;
-      }
+// The glyphs of a bar and their display widths, measured once when the
+// indicator's BarWidth, Fill, Lead or Remainder change rather than on every
+// frame.
+class ProgressScale {
+public:
+  static constexpr bool depends_on(ProgressBarOption id) {
+    return id == ProgressBarOption::bar_width || id == ProgressBarOption::fill ||
+           id == ProgressBarOption::lead || id == ProgressBarOption::remainder;
+  }
 
-      os << next;
+  void assign(size_t bar_width, const std::string &fill, const std::string &lead,
+              const std::string &remainder) {
+    bar_width_ = bar_width;
+    fill_.assign(fill, bar_width);
+    lead_.assign(lead, bar_width);
+    remainder_.assign(remainder, bar_width);
+  }
+
+  size_t bar_width() const { return bar_width_; }
+
+  // Fills the cells before pos, puts the lead at pos and the remainder after
+  // it. A glyph that would overflow the bar is replaced by spaces.
+  FrameBuffer &write(FrameBuffer &os, size_t pos) const {
+    const auto fills = (std::min)((pos + fill_.width - 1) / fill_.width, bar_width_ / fill_.width);
+    fill_.write(os, fills);
+    auto i = fills * fill_.width;
+    if (i >= bar_width_)
+      return os;
+    if (i < pos)
+      return os.append(bar_width_ - i, ' ');
+
+    if (i == pos) {
+      if (i + lead_.width > bar_width_)
+        return os.append(bar_width_ - i, ' ');
+      lead_.write(os, 1);
+      i += lead_.width;
     }
-    return os;
+
+    const auto remainders = (bar_width_ - i) / remainder_.width;
+    remainder_.write(os, remainders);
+    i += remainders * remainder_.width;
+    return os.append(bar_width_ - i, ' ');
   }
 
 private:
-  std::ostream &os;
-  size_t bar_width = 0;
-  std::string fill;
-  std::string lead;
-  std::string remainder;
+  size_t bar_width_ = 0;
+  GlyphRun fill_;
+  GlyphRun lead_;
+  GlyphRun remainder_;
 };
 
+class ProgressScaleWriter {
+public:
+  ProgressScaleWriter(FrameBuffer &os, const ProgressScale &scale) : os(os), scale(scale) {}
+
+  FrameBuffer &write(float progress) {
+    return scale.write(os, static_cast<size_t>(progress * scale.bar_width() / 100.0));
+  }
+
+private:
+  FrameBuffer &os;
+  const ProgressScale &scale;
+};
+
+// Draws a scale assigned with the fill as its remainder, so that the lead
+// moves over an otherwise filled bar
 class IndeterminateProgressScaleWriter {
 public:
-  IndeterminateProgressScaleWriter(std::ostream &os, size_t bar_width, const std::string &fill,
-                                   const std::string &lead)
-      : os(os), bar_width(bar_width), fill(fill), lead(lead) {}
-
-  std::ostream &write(size_t progress) {
-    for (size_t i = 0; i < bar_width;) {
-      std::string next;
-      size_t current_display_width = 0;
-
-      if (i < progress) {
-        next = fill;
-        current_display_width = unicode::display_width(fill);
-      } else if (i == progress) {
-        next = lead;
-        current_display_width = unicode::display_width(lead);
-      } else {
-        next = fill;
-        current_display_width = unicode::display_width(fill);
-      }
+  IndeterminateProgressScaleWriter(FrameBuffer &os, const ProgressScale &scale)
+      : os(os), scale(scale) {}
 
-      i += current_display_width;
+  FrameBuffer &write(size_t progress) { return scale.write(os, progress); }
 
-      if (i > bar_width) {
-        // `next` is larger than the allowed bar width
-        // fill with empty space instead
-        os << std::string((bar_width - (i - current_display_width)), ' ');
-        break;
-      }
+private:
+  FrameBuffer &os;
+  const ProgressScale &scale;
+};
+
+} // namespace details
+} // namespace indicators
+
+#endif
 
-      os << next;
+
+#ifndef INDICATORS_RENDER_SCHEDULER
+#define INDICATORS_RENDER_SCHEDULER
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace indicators {
+
+// A single background thread that draws attached indicators at a fixed frame
+// rate. Once attached, tick() and friends only update counters and notify the
+// scheduler; formatting and terminal I/O move off the calling thread. Each
+// frame draws only the indicators that changed, and the thread sleeps until
+// something does, so idle indicators cost nothing. Frames that complete an
+// indicator are still drawn by the thread that completes it, so they are
+// never lost at exit.
+class RenderScheduler {
+public:
+  static RenderScheduler &instance() {
+    static RenderScheduler scheduler;
+    return scheduler;
+  }
+
+  RenderScheduler(const RenderScheduler &) = delete;
+  RenderScheduler &operator=(const RenderScheduler &) = delete;
+
+  ~RenderScheduler() {
+    {
+      std::lock_guard<std::mutex> lock{wake_mutex_};
+      stop_ = true;
     }
-    return os;
+    wake_.notify_one();
+    if (thread_.joinable())
+      thread_.join();
+
+    // Indicators that outlive the scheduler go back to drawing themselves
+    std::lock_guard<std::mutex> lock{indicators_mutex_};
+    for (auto &entry : indicators_)
+      *entry.scheduled = false;
+  }
+
+  void set_frame_rate(size_t frames_per_second) {
+    frame_interval_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::seconds(1))
+                          .count() /
+                      static_cast<long long>((std::max)(frames_per_second, size_t(1)));
+  }
+
+  template <typename Indicator> void attach(Indicator &indicator) {
+    {
+      std::lock_guard<std::mutex> lock{indicators_mutex_};
+      indicators_.push_back(Entry{&indicator, &indicator.render_scheduled_,
+                                  &indicator.render_pending_,
+                                  [&indicator]() { draw(indicator, 0); }});
+      indicator.render_scheduled_ = true;
+      if (!thread_.joinable())
+        thread_ = std::thread(&RenderScheduler::run, this);
+    }
+    notify(indicator.render_pending_);
+  }
+
+  template <typename Indicator> void detach(Indicator &indicator) {
+    std::lock_guard<std::mutex> lock{indicators_mutex_};
+    indicator.render_scheduled_ = false;
+    indicators_.erase(std::remove_if(indicators_.begin(), indicators_.end(),
+                                     [&indicator](const Entry &entry) {
+                                       return entry.indicator == &indicator;
+                                     }),
+                      indicators_.end());
+  }
+
+  // Called by attached indicators whenever their state changes. Only the
+  // first change after the indicator was last drawn takes the lock to wake
+  // the thread.
+  void notify(std::atomic<bool> &indicator_pending) {
+    if (indicator_pending.exchange(true) || pending_.exchange(true))
+      return;
+    std::lock_guard<std::mutex> lock{wake_mutex_};
+    wake_.notify_one();
   }
 
 private:
-  std::ostream &os;
-  size_t bar_width = 0;
-  std::string fill;
-  std::string lead;
+  RenderScheduler() = default;
+
+  // Draws a frame for the changes of an indicator, skipping it if the
+  // indicator can tell that it would look the same as the last one
+  template <typename Indicator>
+  static auto draw(Indicator &indicator, int)
+      -> decltype(indicator.print_progress_if_changed()) {
+    indicator.print_progress_if_changed();
+  }
+  template <typename Indicator> static void draw(Indicator &indicator, long) {
+    indicator.print_progress();
+  }
+
+  struct Entry {
+    const void *indicator;
+    std::atomic<bool> *scheduled;
+    std::atomic<bool> *pending;
+    std::function<void()> print_progress;
+  };
+
+  void run() {
+    std::unique_lock<std::mutex> lock{wake_mutex_};
+    while (true) {
+      wake_.wait(lock, [this] { return stop_ || pending_; });
+      if (stop_)
+        break;
+      const auto next_frame = std::chrono::steady_clock::now() +
+                              std::chrono::nanoseconds(frame_interval_.load());
+      pending_ = false;
+      lock.unlock();
+      print_progress();
+      lock.lock();
+      // Changes arriving before the next frame is due are drawn together
+      wake_.wait_until(lock, next_frame, [this] { return stop_; });
+    }
+    lock.unlock();
+    if (pending_)
+      print_progress();
+  }
+
+  void print_progress() {
+    std::lock_guard<std::mutex> lock{indicators_mutex_};
+    for (auto &entry : indicators_)
+      if (entry.pending->exchange(false))
+        entry.print_progress();
+  }
+
+  std::mutex indicators_mutex_;
+  std::vector<Entry> indicators_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  bool stop_{false};
+  std::atomic<bool> pending_{false};
+  std::atomic<long long> frame_interval_{1000000000LL / 30};
+  std::thread thread_;
 };
 
-} // namespace details
 } // namespace indicators
 
 #endif
 
 
+
 #ifndef INDICATORS_PROGRESS_BAR
 #define INDICATORS_PROGRESS_BAR
 
+// #include <indicators/details/frame_buffer.hpp>
+// #include <indicators/details/redraw_throttle.hpp>
+#ifndef INDICATORS_REDRAW_THROTTLE
+#define INDICATORS_REDRAW_THROTTLE
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace indicators {
+namespace details {
+
+// Remembers when an indicator last drew a frame, so that frames arriving
+// faster than option::MinRedrawInterval can be skipped. is_due() may be called
+// from any thread without holding the indicator's mutex.
+class RedrawThrottle {
+public:
+  bool is_due(std::chrono::nanoseconds min_interval) const {
+    if (min_interval.count() <= 0)
+      return true;
+    const auto last = last_redraw_.load(std::memory_order_relaxed);
+    return last == never || now() - last >= min_interval.count();
+  }
+
+  void redrawn() { last_redraw_.store(now(), std::memory_order_relaxed); }
+
+private:
+  static constexpr long long never = -1;
+
+  static long long now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  std::atomic<long long> last_redraw_{never};
+};
+
+// The handful of numbers that decide what a frame looks like. Most ticks of a
+// long run leave all of them unchanged, and such a frame need not be drawn.
+struct VisibleState {
+  size_t cells{0};
+  size_t percentage{0};
+  long long elapsed_seconds{0};
+  long long remaining_seconds{0};
+  size_t settings_version{0};
+  bool completed{false};
+};
+
+inline bool operator==(const VisibleState &lhs, const VisibleState &rhs) {
+  return lhs.cells == rhs.cells && lhs.percentage == rhs.percentage &&
+         lhs.elapsed_seconds == rhs.elapsed_seconds &&
+         lhs.remaining_seconds == rhs.remaining_seconds &&
+         lhs.settings_version == rhs.settings_version && lhs.completed == rhs.completed;
+}
+
+inline bool operator!=(const VisibleState &lhs, const VisibleState &rhs) { return !(lhs == rhs); }
+
+} // namespace details
+} // namespace indicators
+
+#endif
+
+// #include <indicators/details/sharded_counter.hpp>
+#ifndef INDICATORS_SHARDED_COUNTER
+#define INDICATORS_SHARDED_COUNTER
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace indicators {
+namespace details {
+
+// A signed counter split into cache-line sized slots. Each thread adds into
+// its own slot, so many cores can count concurrently without bouncing a
+// shared cache line between them. A slot moves its count into the shared
+// total once it holds a batch either way, so the shared line is only written
+// once per batch and the total is always known to within spread() of
+// flushed() without reading the slots. Reading the exact value sums all
+// slots, which is left to the renderer and to updates that may have reached
+// the end.
+class ShardedCounter {
+public:
+  static constexpr long long batch = 64;
+
+  ShardedCounter() : slot_count_(round_up_to_power_of_two(std::thread::hardware_concurrency())),
+                     slots_(new Slot[slot_count_]) {}
+
+  void add(long long n) {
+    auto &slot = slots_[thread_index() & (slot_count_ - 1)].value;
+    const long long value = slot.fetch_add(n) + n;
+    if (value >= batch || value <= -batch)
+      flushed_.value.fetch_add(slot.exchange(0));
+  }
+
+  // The part of the count that has left the slots
+  long long flushed() const { return flushed_.value.load(); }
+
+  // How far sum() can be from flushed(): after each add(), every slot holds
+  // less than a batch either way
+  long long spread() const { return static_cast<long long>(slot_count_) * (batch - 1); }
+
+  long long sum() const {
+    long long result = flushed_.value.load();
+    for (size_t i = 0; i < slot_count_; ++i)
+      result += slots_[i].value.load();
+    return result;
+  }
+
+  // Ticks that race with reset() either happen before it and are cleared,
+  // or after it and are kept. A count that a slot is moving into the total
+  // when reset() runs lands in the total afterwards, so it is kept too.
+  void reset() {
+    for (size_t i = 0; i < slot_count_; ++i)
+      slots_[i].value.store(0);
+    flushed_.value.store(0);
+  }
+
+private:
+  static constexpr size_t cache_line_size = 64;
+
+  // Padded so that consecutive slots never share a cache line, whatever the
+  // alignment of the array itself
+  struct Slot {
+    std::atomic<long long> value{0};
+    char padding[cache_line_size - sizeof(std::atomic<long long>)];
+  };
+
+  static size_t round_up_to_power_of_two(size_t n) {
+    size_t result = 1;
+    while (result < n)
+      result <<= 1;
+    return result;
+  }
+
+  // The lowest number that no live thread holds, taken by a thread the first
+  // time it touches any ShardedCounter and given back when it exits. Up to
+  // hardware_concurrency() live threads get a slot of their own, however
+  // often a thread pool replaces its threads.
+  class ThreadIndex {
+  public:
+    ThreadIndex() {
+      std::lock_guard<std::mutex> lock{mutex()};
+      auto &taken = indices();
+      value = static_cast<size_t>(std::find(taken.begin(), taken.end(), false) - taken.begin());
+      if (value == taken.size())
+        taken.push_back(true);
+      else
+        taken[value] = true;
+    }
+
+    ~ThreadIndex() {
+      std::lock_guard<std::mutex> lock{mutex()};
+      indices()[value] = false;
+    }
+
+    size_t value;
+
+  private:
+    static std::mutex &mutex() {
+      static std::mutex result;
+      return result;
+    }
+
+    static std::vector<bool> &indices() {
+      static std::vector<bool> result;
+      return result;
+    }
+  };
+
+  static size_t thread_index() {
+    thread_local ThreadIndex index;
+    return index.value;
+  }
+
+  // Padded like a slot, so that writing it does not evict the members below,
+  // which every add() reads
+  Slot flushed_;
+  size_t slot_count_;
+  std::unique_ptr<Slot[]> slots_;
+};
+
+} // namespace details
+} // namespace indicators
+
+#endif
+
 // #include <indicators/details/stream_helper.hpp>
+// #include <indicators/details/width_cache.hpp>
+#ifndef INDICATORS_WIDTH_CACHE
+#define INDICATORS_WIDTH_CACHE
+
+// #include <indicators/display_width.hpp>
+// #include <indicators/setting.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace indicators {
+namespace details {
+
+// Process-wide memo of the widths of recently measured texts, for texts that
+// change between frames but keep coming back, such as a postfix that cycles
+// through a few status messages. Each text has one slot, chosen by its hash,
+// and evicts whatever was there, so the cache never holds more than slots
+// texts of at most max_length bytes. Printable ASCII is as wide as it is long
+// and bypasses the cache, and so does a thread that finds the cache locked,
+// so that drawing never waits for it.
+class WidthCache {
+public:
+  static constexpr size_t slots = 64;
+  static constexpr size_t max_length = 256;
+
+  static WidthCache &instance() {
+    static WidthCache cache;
+    return cache;
+  }
+
+  int width(const std::string &text) {
+    const size_t size = text.size();
+    if (unicode::details::printable_ascii_prefix(text.data(), size) == size)
+      return static_cast<int>(size);
+    if (size > max_length)
+      return unicode::display_width(text);
+    const size_t hash = std::hash<std::string>()(text);
+    std::unique_lock<std::mutex> lock{mutex_, std::try_to_lock};
+    if (!lock.owns_lock())
+      return unicode::display_width(text);
+    Entry &entry = entries_[hash % slots];
+    if (entry.hash != hash || entry.text != text) {
+      // Reuses the storage of the text it evicts
+      entry.text.assign(text);
+      entry.hash = hash;
+      entry.width = unicode::display_width(text);
+    }
+    return entry.width;
+  }
+
+private:
+  struct Entry {
+    size_t hash{0};
+    std::string text;
+    int width{0};
+  };
+
+  std::mutex mutex_;
+  Entry entries_[slots];
+};
+
+// The display width of one of an indicator's configured texts, measured when
+// the first frame is drawn and again only after set_option() has changed it
+class CachedWidth {
+public:
+  int get(const std::string &text) {
+    if (stale_) {
+      width_ = WidthCache::instance().width(text);
+      stale_ = false;
+    }
+    return width_;
+  }
+
+  void invalidate() { stale_ = true; }
+
+private:
+  int width_{0};
+  bool stale_{true};
+};
+
+// Widths of the texts that a progress bar draws around its scale
+struct TextWidths {
+  CachedWidth prefix;
+  CachedWidth postfix;
+  CachedWidth start;
+  CachedWidth end;
+
+  void invalidate(ProgressBarOption id) {
+    switch (id) {
+    case ProgressBarOption::prefix_text:
+      prefix.invalidate();
+      break;
+    case ProgressBarOption::postfix_text:
+      postfix.invalidate();
+      break;
+    case ProgressBarOption::start:
+      start.invalidate();
+      break;
+    case ProgressBarOption::end:
+      end.invalidate();
+      break;
+    default:
+      break;
+    }
+  }
+};
+
+} // namespace details
+} // namespace indicators
+
+#endif
+
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 // #include <indicators/color.hpp>
+// #include <indicators/render_scheduler.hpp>
 // #include <indicators/setting.hpp>
 // #include <indicators/terminal_size.hpp>
 #include <iomanip>
 #include <iostream>
-#include <sstream>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -1951,7 +4036,8 @@ class ProgressBar {
                  option::ShowElapsedTime, option::ShowRemainingTime,
                  option::SavedStartTime, option::ForegroundColor,
                  option::FontStyles, option::MinProgress, option::MaxProgress,
-                 option::ProgressType, option::Stream>;
+                 option::ProgressType, option::Stream,
+                 option::MinRedrawInterval, option::ShardedProgress>;
 
 public:
   template <typename... Args,
@@ -2003,7 +4089,12 @@ public:
                 option::ProgressType{ProgressType::incremental},
                 std::forward<Args>(args)...),
             details::get<details::ProgressBarOption::stream>(
-                option::Stream{std::cout}, std::forward<Args>(args)...)) {
+                option::Stream{std::cout}, std::forward<Args>(args)...),
+            details::get<details::ProgressBarOption::min_redraw_interval>(
+                option::MinRedrawInterval{std::chrono::nanoseconds::zero()},
+                std::forward<Args>(args)...),
+            details::get<details::ProgressBarOption::sharded_progress>(
+                option::ShardedProgress{false}, std::forward<Args>(args)...)) {
 
     // if progress is incremental, start from min_progress
     // else start from max_progress
@@ -2012,6 +4103,15 @@ public:
       progress_ = get_value<details::ProgressBarOption::min_progress>();
     else
       progress_ = get_value<details::ProgressBarOption::max_progress>();
+    completed_ = get_value<details::ProgressBarOption::completed>();
+    refresh_limits();
+    if (get_value<details::ProgressBarOption::sharded_progress>())
+      shards_.reset(new details::ShardedCounter);
+  }
+
+  ~ProgressBar() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -2022,6 +4122,13 @@ public:
         "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = std::move(setting).value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    if (details::ProgressScale::depends_on(id))
+      scale_stale_ = true;
+    text_widths_.invalidate(id);
+    refresh_limits();
+    ++settings_version_;
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -2032,6 +4139,13 @@ public:
         "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = setting.value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    if (details::ProgressScale::depends_on(id))
+      scale_stale_ = true;
+    text_widths_.invalidate(id);
+    refresh_limits();
+    ++settings_version_;
   }
 
   void
@@ -2044,6 +4158,8 @@ public:
       get_value<details::ProgressBarOption::max_postfix_text_len>() =
           setting.value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
   void set_option(
@@ -2058,45 +4174,74 @@ public:
       get_value<details::ProgressBarOption::max_postfix_text_len>() =
           new_value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
-  void set_progress(size_t new_progress) {
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      progress_ = new_progress;
-    }
+  void set_option(
+      const details::Setting<bool, details::ProgressBarOption::completed>
+          &setting) {
+    completed_ = setting.value;
+  }
 
-    save_start_time();
-    print_progress();
+  void set_option(
+      details::Setting<bool, details::ProgressBarOption::completed> &&setting) {
+    completed_ = setting.value;
   }
 
-  void tick() {
-    {
-      std::lock_guard<std::mutex> lock{mutex_};
-      const auto type = get_value<details::ProgressBarOption::progress_type>();
-      if (type == ProgressType::incremental)
-        progress_ += 1;
-      else
-        progress_ -= 1;
-    }
-    save_start_time();
-    print_progress();
+  // With ShardedProgress, the shards are cleared before the new value is
+  // stored, so a tick that runs concurrently counts either before the new
+  // value, which replaces it, or on top of it; none is lost.
+  void set_progress(size_t new_progress) {
+    if (shards_)
+      shards_->reset();
+    progress_.store(new_progress, std::memory_order_relaxed);
+    print_progress_if_due(new_progress);
   }
 
-  size_t current() {
-    std::lock_guard<std::mutex> lock{mutex_};
-    return (std::min)(
-        progress_,
-        size_t(get_value<details::ProgressBarOption::max_progress>()));
+  void tick() { advance(1); }
+
+  void advance(size_t n) {
+    const bool decremental = decremental_.load(std::memory_order_relaxed);
+    if (shards_) {
+      shards_->add(decremental ? -static_cast<long long>(n) : static_cast<long long>(n));
+      // Only a frame that is due, or a tick close enough to the end that it
+      // may have reached it, pays for summing the shards
+      if (may_be_final_sharded())
+        print_progress_if_due(load_progress());
+      else if (render_scheduled_)
+        RenderScheduler::instance().notify(render_pending_);
+      else if (throttle_.is_due(min_redraw_interval()))
+        print_progress_if_due(load_progress());
+      return;
+    }
+    if (!decremental) {
+      print_progress_if_due(progress_.fetch_add(n, std::memory_order_relaxed) + n);
+      return;
+    }
+    // Stops at MinProgress instead of wrapping around below zero, where the
+    // bar would look full and never complete
+    const size_t min_progress = min_progress_.load(std::memory_order_relaxed);
+    size_t progress = progress_.load(std::memory_order_relaxed);
+    size_t new_progress;
+    do {
+      new_progress = progress > min_progress && progress - min_progress > n
+                         ? progress - n
+                         : (std::min)(progress, min_progress);
+    } while (!progress_.compare_exchange_weak(progress, new_progress,
+                                              std::memory_order_relaxed));
+    print_progress_if_due(new_progress);
   }
 
-  bool is_completed() const {
-    return get_value<details::ProgressBarOption::completed>();
+  size_t current() const {
+    return (std::min)(load_progress(), max_progress_.load(std::memory_order_relaxed));
   }
 
+  bool is_completed() const { return completed_; }
+
   void mark_as_completed() {
-    get_value<details::ProgressBarOption::completed>() = true;
-    print_progress();
+    completed_ = true;
+    print_progress_if_changed();
   }
 
 private:
@@ -2112,16 +4257,114 @@ private:
     return details::get_value<id>(settings_).value;
   }
 
-  size_t progress_{0};
+  std::atomic<size_t> progress_{0};
+  // With option::ShardedProgress, ticks accumulate here instead of in
+  // progress_, which then only holds the value last given to set_progress()
+  std::unique_ptr<details::ShardedCounter> shards_;
+  std::atomic<bool> completed_{false};
   Settings settings_;
+  // Copies of max_progress, min_progress, progress_type and
+  // min_redraw_interval, kept by refresh_limits()
+  std::atomic<size_t> min_progress_{0};
+  std::atomic<size_t> max_progress_{0};
+  std::atomic<bool> decremental_{false};
+  std::atomic<long long> min_redraw_interval_{0};
   std::chrono::nanoseconds elapsed_;
   std::chrono::time_point<std::chrono::high_resolution_clock> start_time_point_;
   std::mutex mutex_;
+  details::RedrawThrottle throttle_;
+  // Bumped by set_option() so that a changed setting forces a redraw;
+  // starts ahead of last_state_ so that the first frame is always drawn.
+  size_t settings_version_{1};
+  details::VisibleState last_state_;
+  details::FrameBuffer frame_;
+  // Rebuilt before the next frame whenever set_option() changes a glyph, or
+  // the colour or font styles
+  details::ProgressScale scale_;
+  bool scale_stale_{true};
+  details::StylePrefix style_;
+  bool style_stale_{true};
+  // Display widths of the prefix, postfix, start and end texts
+  details::TextWidths text_widths_;
 
   template <typename Indicator, size_t count> friend class MultiProgress;
   template <typename Indicator> friend class DynamicProgress;
   std::atomic<bool> multi_progress_mode_{false};
 
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  size_t load_progress() const {
+    const auto progress = progress_.load(std::memory_order_relaxed);
+    if (!shards_)
+      return progress;
+    // Decremental ticks past zero count as zero rather than wrapping around
+    const auto sum = shards_->sum();
+    return sum < 0 && static_cast<size_t>(-sum) > progress ? 0
+                                                           : progress + static_cast<size_t>(sum);
+  }
+
+  // Copies the settings that tick() and set_progress() read without the
+  // lock; called under the lock whenever set_option() may have changed them
+  void refresh_limits() {
+    min_progress_.store(get_value<details::ProgressBarOption::min_progress>(),
+                        std::memory_order_relaxed);
+    max_progress_.store(get_value<details::ProgressBarOption::max_progress>(),
+                        std::memory_order_relaxed);
+    decremental_.store(get_value<details::ProgressBarOption::progress_type>() ==
+                           ProgressType::decremental,
+                       std::memory_order_relaxed);
+    min_redraw_interval_.store(
+        get_value<details::ProgressBarOption::min_redraw_interval>().count(),
+        std::memory_order_relaxed);
+  }
+
+  std::chrono::nanoseconds min_redraw_interval() const {
+    return std::chrono::nanoseconds(min_redraw_interval_.load(std::memory_order_relaxed));
+  }
+
+  // Whether the sharded progress, known to within the spread of the shards
+  // without summing them, could have reached the end
+  bool may_be_final_sharded() const {
+    const auto progress = static_cast<long long>(progress_.load(std::memory_order_relaxed)) +
+                          shards_->flushed();
+    return decremental_.load(std::memory_order_relaxed)
+               ? progress - shards_->spread() <=
+                     static_cast<long long>(min_progress_.load(std::memory_order_relaxed))
+               : progress + shards_->spread() >=
+                     static_cast<long long>(max_progress_.load(std::memory_order_relaxed));
+  }
+
+  bool is_final_progress(size_t progress) const {
+    return decremental_.load(std::memory_order_relaxed)
+               ? progress <= min_progress_.load(std::memory_order_relaxed)
+               : progress >= max_progress_.load(std::memory_order_relaxed);
+  }
+
+  // tick() and set_progress() only publish the new value; a frame is drawn
+  // unless the RenderScheduler draws this bar, MinRedrawInterval has not
+  // elapsed since the last one, or another thread is busy drawing one, in
+  // which case that thread's frame (or the next one) will show it. The final
+  // frame is never skipped.
+  void print_progress_if_due(size_t progress) {
+    if (is_final_progress(progress)) {
+      print_progress_if_changed();
+      return;
+    }
+    if (multi_progress_mode_)
+      return;
+    if (render_scheduled_) {
+      RenderScheduler::instance().notify(render_pending_);
+      return;
+    }
+    if (!throttle_.is_due(min_redraw_interval()))
+      return;
+    std::unique_lock<std::mutex> lock{mutex_, std::try_to_lock};
+    if (lock.owns_lock())
+      draw_progress(false, true);
+  }
+
   void save_start_time() {
     auto &show_elapsed_time =
         get_value<details::ProgressBarOption::show_elapsed_time>();
@@ -2135,25 +4378,76 @@ private:
     }
   }
 
-  std::pair<std::string, int> get_prefix_text() {
-    std::stringstream os;
-    os << get_value<details::ProgressBarOption::prefix_text>();
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+  std::chrono::nanoseconds remaining_time(size_t progress) const {
+    const auto max_progress =
+        get_value<details::ProgressBarOption::max_progress>();
+    auto eta = std::chrono::nanoseconds(
+        progress > 0 ? static_cast<long long>(std::ceil(
+                           float(elapsed_.count()) * max_progress / progress))
+                     : 0);
+    return eta > elapsed_ ? (eta - elapsed_) : (elapsed_ - eta);
+  }
+
+  details::VisibleState visible_state(size_t progress) const {
+    const auto max_progress =
+        get_value<details::ProgressBarOption::max_progress>();
+    const auto saved_start_time =
+        get_value<details::ProgressBarOption::saved_start_time>();
+    const auto percentage = double(progress) / double(max_progress) * 100.0f;
+
+    details::VisibleState state;
+    state.cells = static_cast<size_t>(
+        float(percentage) *
+        get_value<details::ProgressBarOption::bar_width>() / 100.0);
+    if (get_value<details::ProgressBarOption::show_percentage>())
+      state.percentage = (std::min)(
+          static_cast<size_t>(static_cast<float>(progress) / max_progress * 100),
+          size_t(100));
+    if (get_value<details::ProgressBarOption::show_elapsed_time>() &&
+        saved_start_time)
+      state.elapsed_seconds =
+          std::chrono::duration_cast<std::chrono::seconds>(elapsed_).count();
+    if (get_value<details::ProgressBarOption::show_remaining_time>() &&
+        saved_start_time)
+      state.remaining_seconds =
+          std::chrono::duration_cast<std::chrono::seconds>(
+              remaining_time(progress))
+              .count();
+    state.settings_version = settings_version_;
+    state.completed = completed_ || is_final_progress(progress);
+    return state;
+  }
+
+  // Whether the line last drawn for MultiProgress no longer shows the current
+  // state, so that it only redraws the bars that changed
+  bool changed_since_drawn() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    save_start_time();
+    if (!completed_)
+      elapsed_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::high_resolution_clock::now() - start_time_point_);
+    return visible_state(load_progress()) != last_state_;
+  }
+
+  // Appends the prefix text to frame_ and returns its display width
+  int write_prefix_text() {
+    const auto &prefix_text = get_value<details::ProgressBarOption::prefix_text>();
+    frame_ << prefix_text;
+    return text_widths_.prefix.get(prefix_text);
   }
 
-  std::pair<std::string, int> get_postfix_text() {
-    std::stringstream os;
+  // Appends the postfix text to frame_ and returns its display width
+  int write_postfix_text(size_t progress) {
+    auto &os = frame_;
+    const auto begin = os.size();
     const auto max_progress =
         get_value<details::ProgressBarOption::max_progress>();
 
     if (get_value<details::ProgressBarOption::show_percentage>()) {
-      os << " "
-         << (std::min)(static_cast<size_t>(static_cast<float>(progress_) /
-                                         max_progress * 100),
-                     size_t(100))
-         << "%";
+      os << ' ';
+      details::write_percentage(
+          os, (std::min)(static_cast<float>(progress) / max_progress * 100,
+                         100.0f));
     }
 
     auto &saved_start_time =
@@ -2174,13 +4468,7 @@ private:
         os << " [";
 
       if (saved_start_time) {
-        auto eta = std::chrono::nanoseconds(
-            progress_ > 0
-                ? static_cast<long long>(std::ceil(float(elapsed_.count()) *
-                                                   max_progress / progress_))
-                : 0);
-        auto remaining = eta > elapsed_ ? (eta - elapsed_) : (elapsed_ - eta);
-        details::write_duration(os, remaining);
+        details::write_duration(os, remaining_time(progress));
       } else {
         os << "00:00s";
       }
@@ -2191,89 +4479,130 @@ private:
         os << "]";
     }
 
-    os << " " << get_value<details::ProgressBarOption::postfix_text>();
+    os << ' ';
 
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+    // Everything written so far is ASCII, one column per byte
+    const auto &postfix_text = get_value<details::ProgressBarOption::postfix_text>();
+    const auto postfix_width = text_widths_.postfix.get(postfix_text);
+    const int result_size =
+        postfix_width == -1 ? -1 : int(os.size() - begin) + postfix_width;
+    os << postfix_text;
+    return result_size;
   }
 
-public:
-  void print_progress(bool from_multi_progress = false) {
-    std::lock_guard<std::mutex> lock{mutex_};
-
+  // Skips the frame if_changed and it would look the same as the last one.
+  // Updates skip it; MultiProgress, which has moved the cursor onto this
+  // line, and explicit calls to print_progress() always draw.
+  void draw_progress(bool from_multi_progress, bool if_changed = false) {
     auto &os = get_value<details::ProgressBarOption::stream>();
 
-    const auto type = get_value<details::ProgressBarOption::progress_type>();
-    const auto min_progress =
-        get_value<details::ProgressBarOption::min_progress>();
+    const auto progress = load_progress();
     const auto max_progress =
         get_value<details::ProgressBarOption::max_progress>();
     if (multi_progress_mode_ && !from_multi_progress) {
-      if ((type == ProgressType::incremental && progress_ >= max_progress) ||
-          (type == ProgressType::decremental && progress_ <= min_progress)) {
-        get_value<details::ProgressBarOption::completed>() = true;
+      if (is_final_progress(progress)) {
+        completed_ = true;
       }
       return;
     }
+    save_start_time();
     auto now = std::chrono::high_resolution_clock::now();
-    if (!get_value<details::ProgressBarOption::completed>())
+    if (!completed_)
       elapsed_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
           now - start_time_point_);
 
-    if (get_value<details::ProgressBarOption::foreground_color>() !=
-        Color::unspecified)
-      details::set_stream_color(
-          os, get_value<details::ProgressBarOption::foreground_color>());
-
-    for (auto &style : get_value<details::ProgressBarOption::font_styles>())
-      details::set_font_style(os, style);
-
-    const auto prefix_pair = get_prefix_text();
-    const auto prefix_text = prefix_pair.first;
-    const auto prefix_length = prefix_pair.second;
-    os << "\r" << prefix_text;
-
-    os << get_value<details::ProgressBarOption::start>();
+    const auto state = visible_state(progress);
+    if (if_changed && state == last_state_)
+      return;
+    last_state_ = state;
 
-    details::ProgressScaleWriter writer{
-        os, get_value<details::ProgressBarOption::bar_width>(),
-        get_value<details::ProgressBarOption::fill>(),
-        get_value<details::ProgressBarOption::lead>(),
-        get_value<details::ProgressBarOption::remainder>()};
-    writer.write(double(progress_) / double(max_progress) * 100.0f);
+    frame_.clear();
+    if (style_stale_) {
+      style_.assign(get_value<details::ProgressBarOption::foreground_color>(),
+                    get_value<details::ProgressBarOption::font_styles>());
+      style_stale_ = false;
+    }
+    style_.write(frame_, os);
+    frame_ << '\r';
+    const auto prefix_length = write_prefix_text();
+
+    frame_ << get_value<details::ProgressBarOption::start>();
+
+    if (scale_stale_) {
+      scale_.assign(get_value<details::ProgressBarOption::bar_width>(),
+                    get_value<details::ProgressBarOption::fill>(),
+                    get_value<details::ProgressBarOption::lead>(),
+                    get_value<details::ProgressBarOption::remainder>());
+      scale_stale_ = false;
+    }
+    details::ProgressScaleWriter writer{frame_, scale_};
+    writer.write(double(progress) / double(max_progress) * 100.0f);
 
-    os << get_value<details::ProgressBarOption::end>();
+    frame_ << get_value<details::ProgressBarOption::end>();
 
-    const auto postfix_pair = get_postfix_text();
-    const auto postfix_text = postfix_pair.first;
-    const auto postfix_length = postfix_pair.second;
-    os << postfix_text;
+    const auto postfix_length = write_postfix_text(progress);
 
     // Get length of prefix text and postfix text
-    const auto start_length = get_value<details::ProgressBarOption::start>().size();
+    const auto start_length =
+        text_widths_.start.get(get_value<details::ProgressBarOption::start>());
     const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
-    const auto end_length = get_value<details::ProgressBarOption::end>().size();
-    const auto terminal_width = terminal_size().second;
-    // prefix + bar_width + postfix should be <= terminal_width
-    const int remaining = terminal_width - (prefix_length + start_length + bar_width + end_length + postfix_length);
-    if (prefix_length == -1 || postfix_length == -1) {
-      os << "\r";
+    const auto end_length = text_widths_.end.get(get_value<details::ProgressBarOption::end>());
+    const auto terminal_width = terminal_size(os).second;
+    // prefix + bar_width + postfix should be <= terminal_width; a stream that
+    // is not a terminal has no line to pad
+    const int remaining =
+        terminal_width > 0
+            ? int(terminal_width) - int(prefix_length + start_length + bar_width + end_length +
+                                        postfix_length)
+            : 0;
+    if (prefix_length == -1 || postfix_length == -1 || start_length == -1 ||
+        end_length == -1) {
+      frame_ << '\r';
     } else if (remaining > 0) {
-      os << std::string(remaining, ' ') << "\r";
+      frame_.append(remaining, ' ') << '\r';
     } else if (remaining < 0) {
       // Do nothing. Maybe in the future truncate postfix with ...
     }
-    os.flush();
+    throttle_.redrawn();
 
-    if ((type == ProgressType::incremental && progress_ >= max_progress) ||
-        (type == ProgressType::decremental && progress_ <= min_progress)) {
-      get_value<details::ProgressBarOption::completed>() = true;
+    if (is_final_progress(progress)) {
+      completed_ = true;
     }
-    if (get_value<details::ProgressBarOption::completed>() &&
-        !from_multi_progress) // Don't std::endl if calling from MultiProgress
+    // MultiProgress and DynamicProgress write frame_ along with the lines of
+    // their other bars, and end the lines themselves
+    if (from_multi_progress)
+      return;
+    frame_.write_to(os);
+    os.flush();
+    if (completed_)
       os << termcolor::reset << std::endl;
   }
+
+  // Draws a frame for an update, unless it would look the same as the last
+  // one
+  void print_progress_if_changed() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(false, true);
+  }
+
+  // Draws this bar's line into frame without writing it, for MultiProgress
+  // and DynamicProgress, which write the lines of all their bars at once
+  void append_line(details::FrameBuffer &frame) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(true);
+    frame.append(frame_.data(), frame_.size());
+  }
+
+public:
+  void print_progress(bool from_multi_progress = false) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(from_multi_progress);
+    if (from_multi_progress) {
+      auto &os = get_value<details::ProgressBarOption::stream>();
+      frame_.write_to(os);
+      os.flush();
+    }
+  }
 };
 
 } // namespace indicators
@@ -2285,16 +4614,19 @@ public:
 #define INDICATORS_BLOCK_PROGRESS_BAR
 
 // #include <indicators/color.hpp>
+// #include <indicators/details/frame_buffer.hpp>
+// #include <indicators/details/redraw_throttle.hpp>
 // #include <indicators/details/stream_helper.hpp>
+// #include <indicators/details/width_cache.hpp>
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+// #include <indicators/render_scheduler.hpp>
 // #include <indicators/setting.hpp>
 // #include <indicators/terminal_size.hpp>
 #include <iomanip>
 #include <iostream>
-#include <sstream>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -2308,7 +4640,7 @@ class BlockProgressBar {
                               option::PrefixText, option::PostfixText, option::ShowPercentage,
                               option::ShowElapsedTime, option::ShowRemainingTime, option::Completed,
                               option::SavedStartTime, option::MaxPostfixTextLen, option::FontStyles,
-                              option::MaxProgress, option::Stream>;
+                              option::MaxProgress, option::Stream, option::MinRedrawInterval>;
 
 public:
   template <typename... Args,
@@ -2345,7 +4677,15 @@ public:
                   details::get<details::ProgressBarOption::max_progress>(
                       option::MaxProgress{100}, std::forward<Args>(args)...),
                   details::get<details::ProgressBarOption::stream>(option::Stream{std::cout},
-                                                                   std::forward<Args>(args)...)) {}
+                                                                   std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::min_redraw_interval>(
+                      option::MinRedrawInterval{std::chrono::nanoseconds::zero()},
+                      std::forward<Args>(args)...)) {}
+
+  ~BlockProgressBar() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
 
   template <typename T, details::ProgressBarOption id>
   void set_option(details::Setting<T, id> &&setting) {
@@ -2354,6 +4694,10 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = std::move(setting).value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    text_widths_.invalidate(id);
+    ++settings_version_;
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -2363,6 +4707,10 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = setting.value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    text_widths_.invalidate(id);
+    ++settings_version_;
   }
 
   void set_option(
@@ -2372,6 +4720,8 @@ public:
     if (setting.value.length() > get_value<details::ProgressBarOption::max_postfix_text_len>()) {
       get_value<details::ProgressBarOption::max_postfix_text_len>() = setting.value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
   void
@@ -2382,37 +4732,41 @@ public:
     if (new_value.length() > get_value<details::ProgressBarOption::max_postfix_text_len>()) {
       get_value<details::ProgressBarOption::max_postfix_text_len>() = new_value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
   }
 
-  void set_progress(float value) {
+  void set_progress(size_t value) {
     {
       std::lock_guard<std::mutex> lock{mutex_};
-      progress_ = value;
+      tick_ = value;
     }
     save_start_time();
-    print_progress();
+    print_progress_if_due(value);
   }
 
-  void tick() {
+  void tick() { advance(1); }
+
+  void advance(size_t n) {
+    size_t value;
     {
       std::lock_guard<std::mutex> lock{mutex_};
-      progress_ += 1;
+      value = tick_ += n;
     }
     save_start_time();
-    print_progress();
+    print_progress_if_due(value);
   }
 
   size_t current() {
     std::lock_guard<std::mutex> lock{mutex_};
-    return (std::min)(static_cast<size_t>(progress_),
-                    size_t(get_value<details::ProgressBarOption::max_progress>()));
+    return (std::min)(tick_, size_t(get_value<details::ProgressBarOption::max_progress>()));
   }
 
   bool is_completed() const { return get_value<details::ProgressBarOption::completed>(); }
 
   void mark_as_completed() {
     get_value<details::ProgressBarOption::completed>() = true;
-    print_progress();
+    print_progress_if_changed();
   }
 
 private:
@@ -2429,13 +4783,45 @@ private:
 
   Settings settings_;
   float progress_{0.0};
+  size_t tick_{0};
   std::chrono::time_point<std::chrono::high_resolution_clock> start_time_point_;
   std::mutex mutex_;
+  details::RedrawThrottle throttle_;
+  // Bumped by set_option() so that a changed setting forces a redraw;
+  // starts ahead of last_state_ so that the first frame is always drawn.
+  size_t settings_version_{1};
+  details::VisibleState last_state_;
+  details::FrameBuffer frame_;
+  // Rebuilt before the next frame whenever set_option() changes the colour
+  // or font styles
+  details::StylePrefix style_;
+  bool style_stale_{true};
+  // Display widths of the prefix, postfix, start and end texts
+  details::TextWidths text_widths_;
 
   template <typename Indicator, size_t count> friend class MultiProgress;
   template <typename Indicator> friend class DynamicProgress;
   std::atomic<bool> multi_progress_mode_{false};
 
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  // Frames arriving faster than MinRedrawInterval are skipped, and frames of a
+  // bar attached to the RenderScheduler are left to it; the frame that fills
+  // the bar is always drawn.
+  void print_progress_if_due(size_t value) {
+    if (value < get_value<details::ProgressBarOption::max_progress>()) {
+      if (render_scheduled_) {
+        RenderScheduler::instance().notify(render_pending_);
+        return;
+      }
+      if (!throttle_.is_due(get_value<details::ProgressBarOption::min_redraw_interval>()))
+        return;
+    }
+    print_progress_if_changed();
+  }
+
   void save_start_time() {
     auto &show_elapsed_time = get_value<details::ProgressBarOption::show_elapsed_time>();
     auto &saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
@@ -2446,23 +4832,62 @@ private:
     }
   }
 
-  std::pair<std::string, int> get_prefix_text() {
-    std::stringstream os;
-    os << get_value<details::ProgressBarOption::prefix_text>();
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+  std::chrono::nanoseconds elapsed_time() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start_time_point_);
   }
 
-  std::pair<std::string, int> get_postfix_text() {
-    std::stringstream os;
-    const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
-    auto now = std::chrono::high_resolution_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_point_);
+  std::chrono::nanoseconds remaining_time(std::chrono::nanoseconds elapsed) const {
+    auto eta = std::chrono::nanoseconds(
+        tick_ > 0 ? static_cast<long long>(std::ceil(float(elapsed.count()) / progress_)) : 0);
+    return eta > elapsed ? (eta - elapsed) : (elapsed - eta);
+  }
+
+  details::VisibleState visible_state(std::chrono::nanoseconds elapsed) const {
+    const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
+    const auto saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
+    auto value = (std::min)(1.0f, (std::max)(0.0f, progress_));
+    auto whole_width = std::floor(value * bar_width);
+    auto part_width = std::floor(fmod((value * bar_width), 1.0f) * 8);
+
+    details::VisibleState state;
+    state.cells = size_t(whole_width) * 8 + size_t(part_width);
+    if (get_value<details::ProgressBarOption::show_percentage>())
+      state.percentage = (std::min)(static_cast<size_t>(progress_ * 100.0), size_t(100));
+    if (get_value<details::ProgressBarOption::show_elapsed_time>() && saved_start_time)
+      state.elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+    if (get_value<details::ProgressBarOption::show_remaining_time>() && saved_start_time)
+      state.remaining_seconds =
+          std::chrono::duration_cast<std::chrono::seconds>(remaining_time(elapsed)).count();
+    state.settings_version = settings_version_;
+    state.completed = get_value<details::ProgressBarOption::completed>() ||
+                      tick_ > get_value<details::ProgressBarOption::max_progress>();
+    return state;
+  }
+
+  // Whether the line last drawn for MultiProgress no longer shows the current
+  // state, so that it only redraws the bars that changed
+  bool changed_since_drawn() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    progress_ = static_cast<float>(tick_) / get_value<details::ProgressBarOption::max_progress>();
+    return visible_state(elapsed_time()) != last_state_;
+  }
+
+  // Appends the prefix text to frame_ and returns its display width
+  int write_prefix_text() {
+    const auto &prefix_text = get_value<details::ProgressBarOption::prefix_text>();
+    frame_ << prefix_text;
+    return text_widths_.prefix.get(prefix_text);
+  }
+
+  // Appends the postfix text to frame_ and returns its display width
+  int write_postfix_text(std::chrono::nanoseconds elapsed) {
+    auto &os = frame_;
+    const auto begin = os.size();
 
     if (get_value<details::ProgressBarOption::show_percentage>()) {
-      os << " " << (std::min)(static_cast<size_t>(progress_ / max_progress * 100.0), size_t(100))
-         << "%";
+      os << ' ';
+      details::write_percentage(os, (std::min)(progress_ * 100.0, 100.0));
     }
 
     auto &saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
@@ -2482,13 +4907,7 @@ private:
         os << " [";
 
       if (saved_start_time) {
-        auto eta = std::chrono::nanoseconds(
-            progress_ > 0
-                ? static_cast<long long>(std::ceil(float(elapsed.count()) *
-                                                   max_progress / progress_))
-                : 0);
-        auto remaining = eta > elapsed ? (eta - elapsed) : (elapsed - eta);
-        details::write_duration(os, remaining);
+        details::write_duration(os, remaining_time(elapsed));
       } else {
         os << "00:00s";
       }
@@ -2499,74 +4918,121 @@ private:
         os << "]";
     }
 
-    os << " " << get_value<details::ProgressBarOption::postfix_text>();
+    os << ' ';
 
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
+    // Everything written so far is ASCII, one column per byte
+    const auto &postfix_text = get_value<details::ProgressBarOption::postfix_text>();
+    const auto postfix_width = text_widths_.postfix.get(postfix_text);
+    const int result_size = postfix_width == -1 ? -1 : int(os.size() - begin) + postfix_width;
+    os << postfix_text;
+    return result_size;
   }
 
-public:
-  void print_progress(bool from_multi_progress = false) {
-    std::lock_guard<std::mutex> lock{mutex_};
-
+  // Skips the frame if_changed and it would look the same as the last one.
+  // Updates skip it; MultiProgress, which has moved the cursor onto this
+  // line, and explicit calls to print_progress() always draw.
+  void draw_progress(bool from_multi_progress, bool if_changed = false) {
     auto &os = get_value<details::ProgressBarOption::stream>();
 
     const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
     if (multi_progress_mode_ && !from_multi_progress) {
-      if (progress_ > max_progress) {
+      if (tick_ > max_progress) {
         get_value<details::ProgressBarOption::completed>() = true;
       }
       return;
     }
 
-    if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
-      details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
+    // Set before the bar is drawn, so that the bar and the percentage show
+    // the same tick
+    progress_ = static_cast<float>(tick_) / max_progress;
+    const auto elapsed = elapsed_time();
 
-    for (auto &style : get_value<details::ProgressBarOption::font_styles>())
-      details::set_font_style(os, style);
+    const auto state = visible_state(elapsed);
+    if (if_changed && state == last_state_)
+      return;
+    last_state_ = state;
 
-    const auto prefix_pair = get_prefix_text();
-    const auto prefix_text = prefix_pair.first;
-    const auto prefix_length = prefix_pair.second;
-    os << "\r" << prefix_text;
+    frame_.clear();
+    if (style_stale_) {
+      style_.assign(get_value<details::ProgressBarOption::foreground_color>(),
+                    get_value<details::ProgressBarOption::font_styles>());
+      style_stale_ = false;
+    }
+    style_.write(frame_, os);
+    frame_ << '\r';
+    const auto prefix_length = write_prefix_text();
 
-    os << get_value<details::ProgressBarOption::start>();
+    frame_ << get_value<details::ProgressBarOption::start>();
 
-    details::BlockProgressScaleWriter writer{os,
+    details::BlockProgressScaleWriter writer{frame_,
                                              get_value<details::ProgressBarOption::bar_width>()};
-    writer.write(progress_ / max_progress * 100);
+    writer.write(progress_ * 100);
 
-    os << get_value<details::ProgressBarOption::end>();
+    frame_ << get_value<details::ProgressBarOption::end>();
 
-    const auto postfix_pair = get_postfix_text();
-    const auto postfix_text = postfix_pair.first;
-    const auto postfix_length = postfix_pair.second;
-    os << postfix_text;
+    const auto postfix_length = write_postfix_text(elapsed);
 
     // Get length of prefix text and postfix text
-    const auto start_length = get_value<details::ProgressBarOption::start>().size();
+    const auto start_length =
+        text_widths_.start.get(get_value<details::ProgressBarOption::start>());
     const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
-    const auto end_length = get_value<details::ProgressBarOption::end>().size();
-    const auto terminal_width = terminal_size().second;
-    // prefix + bar_width + postfix should be <= terminal_width
-    const int remaining = terminal_width - (prefix_length + start_length + bar_width + end_length + postfix_length);
-    if (prefix_length == -1 || postfix_length == -1) {
-      os << "\r";
+    const auto end_length = text_widths_.end.get(get_value<details::ProgressBarOption::end>());
+    const auto terminal_width = terminal_size(os).second;
+    // prefix + bar_width + postfix should be <= terminal_width; a stream that
+    // is not a terminal has no line to pad
+    const int remaining =
+        terminal_width > 0
+            ? int(terminal_width) - int(prefix_length + start_length + bar_width + end_length +
+                                        postfix_length)
+            : 0;
+    if (prefix_length == -1 || postfix_length == -1 || start_length == -1 ||
+        end_length == -1) {
+      frame_ << '\r';
     } else if (remaining > 0) {
-      os << std::string(remaining, ' ') << "\r";
+      frame_.append(remaining, ' ') << '\r';
     } else if (remaining < 0) {
       // Do nothing. Maybe in the future truncate postfix with ...
     }
-    os.flush();
+    throttle_.redrawn();
 
-    if (progress_ > max_progress) {
+    if (tick_ > max_progress) {
       get_value<details::ProgressBarOption::completed>() = true;
     }
-    if (get_value<details::ProgressBarOption::completed>() &&
-        !from_multi_progress) // Don't std::endl if calling from MultiProgress
+    // MultiProgress and DynamicProgress write frame_ along with the lines of
+    // their other bars, and end the lines themselves
+    if (from_multi_progress)
+      return;
+    frame_.write_to(os);
+    os.flush();
+    if (get_value<details::ProgressBarOption::completed>())
       os << termcolor::reset << std::endl;
   }
+
+  // Draws a frame for an update, unless it would look the same as the last
+  // one
+  void print_progress_if_changed() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(false, true);
+  }
+
+  // Draws this bar's line into frame without writing it, for MultiProgress
+  // and DynamicProgress, which write the lines of all their bars at once
+  void append_line(details::FrameBuffer &frame) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(true);
+    frame.append(frame_.data(), frame_.size());
+  }
+
+public:
+  void print_progress(bool from_multi_progress = false) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(from_multi_progress);
+    if (from_multi_progress) {
+      auto &os = get_value<details::ProgressBarOption::stream>();
+      frame_.write_to(os);
+      os.flush();
+    }
+  }
 };
 
 } // namespace indicators
@@ -2574,16 +5040,21 @@ public:
 #endif
 
 
+
 #ifndef INDICATORS_INDETERMINATE_PROGRESS_BAR
 #define INDICATORS_INDETERMINATE_PROGRESS_BAR
 
+// #include <indicators/details/frame_buffer.hpp>
+// #include <indicators/details/redraw_throttle.hpp>
 // #include <indicators/details/stream_helper.hpp>
+// #include <indicators/details/width_cache.hpp>
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 // #include <indicators/color.hpp>
+// #include <indicators/render_scheduler.hpp>
 // #include <indicators/setting.hpp>
 // #include <indicators/terminal_size.hpp>
 #include <iomanip>
@@ -2593,7 +5064,6 @@ public:
 #include <thread>
 #include <tuple>
 #include <type_traits>
-#include <sstream>
 #include <utility>
 
 namespace indicators {
@@ -2602,7 +5072,8 @@ class IndeterminateProgressBar {
   using Settings =
       std::tuple<option::BarWidth, option::PrefixText, option::PostfixText, option::Start,
                  option::End, option::Fill, option::Lead, option::MaxPostfixTextLen,
-                 option::Completed, option::ForegroundColor, option::FontStyles, option::Stream>;
+                 option::Completed, option::ForegroundColor, option::FontStyles, option::Stream,
+                 option::MinRedrawInterval>;
 
   enum class Direction { forward, backward };
 
@@ -2637,7 +5108,10 @@ public:
                   details::get<details::ProgressBarOption::font_styles>(
                       option::FontStyles{std::vector<FontStyle>{}}, std::forward<Args>(args)...),
                   details::get<details::ProgressBarOption::stream>(option::Stream{std::cout},
-                                                                   std::forward<Args>(args)...)) {
+                                                                   std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::min_redraw_interval>(
+                      option::MinRedrawInterval{std::chrono::nanoseconds::zero()},
+                      std::forward<Args>(args)...)) {
     // starts with [<==>...........]
     // progress_ = 0
 
@@ -2652,6 +5126,11 @@ public:
                     get_value<details::ProgressBarOption::end>().size();
   }
 
+  ~IndeterminateProgressBar() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
+
   template <typename T, details::ProgressBarOption id>
   void set_option(details::Setting<T, id> &&setting) {
     static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(
@@ -2659,6 +5138,12 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = std::move(setting).value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    if (details::ProgressScale::depends_on(id))
+      scale_stale_ = true;
+    text_widths_.invalidate(id);
+    ++settings_version_;
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -2668,6 +5153,12 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = setting.value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
+    if (details::ProgressScale::depends_on(id))
+      scale_stale_ = true;
+    text_widths_.invalidate(id);
+    ++settings_version_;
   }
 
   void set_option(
@@ -2677,158 +5168,526 @@ public:
     if (setting.value.length() > get_value<details::ProgressBarOption::max_postfix_text_len>()) {
       get_value<details::ProgressBarOption::max_postfix_text_len>() = setting.value.length();
     }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
+  }
+
+  void
+  set_option(details::Setting<std::string, details::ProgressBarOption::postfix_text> &&setting) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    get_value<details::ProgressBarOption::postfix_text>() = std::move(setting).value;
+    auto &new_value = get_value<details::ProgressBarOption::postfix_text>();
+    if (new_value.length() > get_value<details::ProgressBarOption::max_postfix_text_len>()) {
+      get_value<details::ProgressBarOption::max_postfix_text_len>() = new_value.length();
+    }
+    text_widths_.postfix.invalidate();
+    ++settings_version_;
+  }
+
+  void tick() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      if (get_value<details::ProgressBarOption::completed>())
+        return;
+
+      progress_ += (direction_ == Direction::forward) ? 1 : -1;
+      if (direction_ == Direction::forward && progress_ == max_progress_) {
+        // time to go back
+        direction_ = Direction::backward;
+      } else if (direction_ == Direction::backward && progress_ == 0) {
+        direction_ = Direction::forward;
+      }
+    }
+    if (render_scheduled_) {
+      RenderScheduler::instance().notify(render_pending_);
+      return;
+    }
+    if (!throttle_.is_due(get_value<details::ProgressBarOption::min_redraw_interval>()))
+      return;
+    print_progress_if_changed();
+  }
+
+  bool is_completed() { return get_value<details::ProgressBarOption::completed>(); }
+
+  void mark_as_completed() {
+    get_value<details::ProgressBarOption::completed>() = true;
+    print_progress_if_changed();
+  }
+
+private:
+  template <details::ProgressBarOption id>
+  auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value)) {
+    return details::get_value<id>(settings_).value;
+  }
+
+  template <details::ProgressBarOption id>
+  auto get_value() const
+      -> decltype((details::get_value<id>(std::declval<const Settings &>()).value)) {
+    return details::get_value<id>(settings_).value;
+  }
+
+  size_t progress_{0};
+  size_t max_progress_;
+  Settings settings_;
+  std::chrono::nanoseconds elapsed_;
+  std::mutex mutex_;
+  details::RedrawThrottle throttle_;
+  // Bumped by set_option() so that a changed setting forces a redraw;
+  // starts ahead of last_state_ so that the first frame is always drawn.
+  size_t settings_version_{1};
+  details::VisibleState last_state_;
+  details::FrameBuffer frame_;
+  // Rebuilt before the next frame whenever set_option() changes a glyph, or
+  // the colour or font styles
+  details::ProgressScale scale_;
+  bool scale_stale_{true};
+  details::StylePrefix style_;
+  bool style_stale_{true};
+  // Display widths of the prefix, postfix, start and end texts
+  details::TextWidths text_widths_;
+
+  template <typename Indicator, size_t count> friend class MultiProgress;
+  template <typename Indicator> friend class DynamicProgress;
+  std::atomic<bool> multi_progress_mode_{false};
+
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  details::VisibleState visible_state() const {
+    details::VisibleState state;
+    state.cells = progress_;
+    state.settings_version = settings_version_;
+    state.completed = get_value<details::ProgressBarOption::completed>();
+    return state;
+  }
+
+  // Whether the line last drawn for MultiProgress no longer shows the current
+  // state, so that it only redraws the bars that changed
+  bool changed_since_drawn() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return visible_state() != last_state_;
+  }
+
+  // Appends the prefix text to frame_ and returns its display width
+  int write_prefix_text() {
+    const auto &prefix_text = get_value<details::ProgressBarOption::prefix_text>();
+    frame_ << prefix_text;
+    return text_widths_.prefix.get(prefix_text);
+  }
+
+  // Appends the postfix text to frame_ and returns its display width
+  int write_postfix_text() {
+    const auto &postfix_text = get_value<details::ProgressBarOption::postfix_text>();
+    const auto postfix_width = text_widths_.postfix.get(postfix_text);
+    frame_ << ' ' << postfix_text;
+    return postfix_width == -1 ? -1 : 1 + postfix_width;
+  }
+
+  // Skips the frame if_changed and it would look the same as the last one.
+  // Updates skip it; MultiProgress, which has moved the cursor onto this
+  // line, and explicit calls to print_progress() always draw.
+  void draw_progress(bool from_multi_progress, bool if_changed = false) {
+    auto &os = get_value<details::ProgressBarOption::stream>();
+
+    if (multi_progress_mode_ && !from_multi_progress) {
+      return;
+    }
+
+    const auto state = visible_state();
+    if (if_changed && state == last_state_)
+      return;
+    last_state_ = state;
+    frame_.clear();
+    if (style_stale_) {
+      style_.assign(get_value<details::ProgressBarOption::foreground_color>(),
+                    get_value<details::ProgressBarOption::font_styles>());
+      style_stale_ = false;
+    }
+    style_.write(frame_, os);
+    frame_ << '\r';
+    const auto prefix_length = write_prefix_text();
+
+    frame_ << get_value<details::ProgressBarOption::start>();
+
+    if (scale_stale_) {
+      scale_.assign(get_value<details::ProgressBarOption::bar_width>(),
+                    get_value<details::ProgressBarOption::fill>(),
+                    get_value<details::ProgressBarOption::lead>(),
+                    get_value<details::ProgressBarOption::fill>());
+      scale_stale_ = false;
+    }
+    details::IndeterminateProgressScaleWriter writer{frame_, scale_};
+    writer.write(progress_);
+
+    frame_ << get_value<details::ProgressBarOption::end>();
+
+    const auto postfix_length = write_postfix_text();
+
+    // Get length of prefix text and postfix text
+    const auto start_length =
+        text_widths_.start.get(get_value<details::ProgressBarOption::start>());
+    const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
+    const auto end_length = text_widths_.end.get(get_value<details::ProgressBarOption::end>());
+    const auto terminal_width = terminal_size(os).second;
+    // prefix + bar_width + postfix should be <= terminal_width; a stream that
+    // is not a terminal has no line to pad
+    const int remaining =
+        terminal_width > 0
+            ? int(terminal_width) - int(prefix_length + start_length + bar_width + end_length +
+                                        postfix_length)
+            : 0;
+    if (prefix_length == -1 || postfix_length == -1 || start_length == -1 ||
+        end_length == -1) {
+      frame_ << '\r';
+    } else if (remaining > 0) {
+      frame_.append(remaining, ' ') << '\r';
+    } else if (remaining < 0) {
+      // Do nothing. Maybe in the future truncate postfix with ...
+    }
+    throttle_.redrawn();
+
+    // MultiProgress and DynamicProgress write frame_ along with the lines of
+    // their other bars, and end the lines themselves
+    if (from_multi_progress)
+      return;
+    frame_.write_to(os);
+    os.flush();
+    if (get_value<details::ProgressBarOption::completed>())
+      os << termcolor::reset << std::endl;
+  }
+
+  // Draws a frame for an update, unless it would look the same as the last
+  // one
+  void print_progress_if_changed() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(false, true);
+  }
+
+  // Draws this bar's line into frame without writing it, for MultiProgress
+  // and DynamicProgress, which write the lines of all their bars at once
+  void append_line(details::FrameBuffer &frame) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(true);
+    frame.append(frame_.data(), frame_.size());
+  }
+
+public:
+  void print_progress(bool from_multi_progress = false) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    draw_progress(from_multi_progress);
+    if (from_multi_progress) {
+      auto &os = get_value<details::ProgressBarOption::stream>();
+      frame_.write_to(os);
+      os.flush();
+    }
+  }
+};
+
+} // namespace indicators
+
+#endif
+
+
+#ifndef INDICATORS_MULTI_PROGRESS
+#define INDICATORS_MULTI_PROGRESS
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// #include <indicators/color.hpp>
+// #include <indicators/cursor_movement.hpp>
+// #include <indicators/details/stream_helper.hpp>
+// #include <indicators/details/terminal_frame.hpp>
+#ifndef INDICATORS_TERMINAL_FRAME
+#define INDICATORS_TERMINAL_FRAME
+
+// #include <indicators/cursor_control.hpp>
+// #include <indicators/cursor_movement.hpp>
+// #include <indicators/details/frame_buffer.hpp>
+// #include <indicators/details/number_format.hpp>
+// #include <indicators/details/stream_helper.hpp>
+// #include <indicators/termcolor.hpp>
+
+#include <cstddef>
+#include <ostream>
+
+namespace indicators {
+namespace details {
+
+// A frame of MultiProgress or DynamicProgress: the cursor movements and the
+// lines of all bars, assembled in one buffer and handed to the stream with a
+// single write(), so that the terminal never shows half a frame. On a
+// terminal, the frame is also wrapped in the synchronized update mode (DEC
+// private mode 2026), which tells terminals that support it to draw the
+// frame only once it is complete; others ignore the unknown mode.
+//
+// On Windows consoles without escape sequences, cursor movements and colours
+// are console calls rather than text, so the buffer is written out before
+// each of them to keep everything in order.
+class TerminalFrame {
+public:
+  void begin(std::ostream &os) {
+    if (os_ != &os) {
+      os_ = &os;
+#if defined(INDICATORS_ANSI_ESCAPE_SEQUENCES) && !defined(_MSC_VER)
+      synchronized_ = termcolor::_internal::is_atty(os);
+#endif
+    }
+    buffer_.clear();
+    if (synchronized_)
+      buffer_ << "\033[?2026h";
+    empty_ = true;
+  }
+
+  void move_up(size_t lines) {
+    if (lines == 0)
+      return;
+    empty_ = false;
+#if defined(_MSC_VER)
+    flush();
+    indicators::move_up(static_cast<int>(lines));
+#else
+    write_unsigned(buffer_ << "\033[", lines) << 'A';
+#endif
   }
 
-  void
-  set_option(details::Setting<std::string, details::ProgressBarOption::postfix_text> &&setting) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    get_value<details::ProgressBarOption::postfix_text>() = std::move(setting).value;
-    auto &new_value = get_value<details::ProgressBarOption::postfix_text>();
-    if (new_value.length() > get_value<details::ProgressBarOption::max_postfix_text_len>()) {
-      get_value<details::ProgressBarOption::max_postfix_text_len>() = new_value.length();
-    }
+  void move_down(size_t lines) {
+    if (lines == 0)
+      return;
+    empty_ = false;
+#if defined(_MSC_VER)
+    flush();
+    indicators::move_down(static_cast<int>(lines));
+#else
+    write_unsigned(buffer_ << "\033[", lines) << 'B';
+#endif
   }
 
-  void tick() {
-    {
-      std::lock_guard<std::mutex> lock{mutex_};
-      if (get_value<details::ProgressBarOption::completed>())
-        return;
+  void erase_line() {
+    empty_ = false;
+#if defined(_MSC_VER)
+    flush();
+    indicators::erase_line();
+#else
+    buffer_ << "\r\033[K";
+#endif
+  }
 
-      progress_ += (direction_ == Direction::forward) ? 1 : -1;
-      if (direction_ == Direction::forward && progress_ == max_progress_) {
-        // time to go back
-        direction_ = Direction::backward;
-      } else if (direction_ == Direction::backward && progress_ == 0) {
-        direction_ = Direction::forward;
-      }
-    }
-    print_progress();
+  // The buffer that the next line is drawn into
+  FrameBuffer &begin_line() {
+    empty_ = false;
+#if !defined(INDICATORS_ANSI_ESCAPE_SEQUENCES)
+    // The bar sets its colour on the stream as it draws the line
+    flush();
+#endif
+    return buffer_;
   }
 
-  bool is_completed() { return get_value<details::ProgressBarOption::completed>(); }
+  void end_line() {
+    buffer_ << '\n';
+#if !defined(INDICATORS_ANSI_ESCAPE_SEQUENCES)
+    flush();
+#endif
+  }
 
-  void mark_as_completed() {
-    get_value<details::ProgressBarOption::completed>() = true;
-    print_progress();
+  // Resets the colour and writes the frame, unless nothing was drawn
+  void end() {
+    if (empty_)
+      return;
+#if defined(INDICATORS_ANSI_ESCAPE_SEQUENCES)
+    if (termcolor::_internal::is_colorized(*os_))
+      buffer_ << "\033[00m";
+#else
+    flush();
+    *os_ << termcolor::reset;
+#endif
+    if (synchronized_)
+      buffer_ << "\033[?2026l";
+    flush();
+    os_->flush();
   }
 
 private:
-  template <details::ProgressBarOption id>
-  auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value)) {
-    return details::get_value<id>(settings_).value;
+  void flush() {
+    buffer_.write_to(*os_);
+    buffer_.clear();
   }
 
-  template <details::ProgressBarOption id>
-  auto get_value() const
-      -> decltype((details::get_value<id>(std::declval<const Settings &>()).value)) {
-    return details::get_value<id>(settings_).value;
-  }
+  std::ostream *os_{nullptr};
+  FrameBuffer buffer_;
+  bool synchronized_{false};
+  bool empty_{true};
+};
 
-  size_t progress_{0};
-  size_t max_progress_;
-  Settings settings_;
-  std::chrono::nanoseconds elapsed_;
-  std::mutex mutex_;
+} // namespace details
+} // namespace indicators
 
-  template <typename Indicator, size_t count> friend class MultiProgress;
-  template <typename Indicator> friend class DynamicProgress;
-  std::atomic<bool> multi_progress_mode_{false};
+#endif
 
-  std::pair<std::string, int> get_prefix_text() {
-    std::stringstream os;
-    os << get_value<details::ProgressBarOption::prefix_text>();
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
-  }
+// #include <indicators/details/viewport.hpp>
+#ifndef INDICATORS_VIEWPORT
+#define INDICATORS_VIEWPORT
 
-  std::pair<std::string, int> get_postfix_text() {
-    std::stringstream os;
-    os << " " << get_value<details::ProgressBarOption::postfix_text>();
+// #include <indicators/details/frame_buffer.hpp>
+// #include <indicators/details/number_format.hpp>
+// #include <indicators/terminal_size.hpp>
 
-    const auto result = os.str();
-    const auto result_size = unicode::display_width(result);
-    return {result, result_size};
-  }
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <vector>
 
+namespace indicators {
+namespace details {
+
+// Picks which of many bars, identified by index, get the rows of a terminal
+// too short to show them all, for MultiProgress and DynamicProgress. Running
+// bars that were updated most recently get rows first, then bars that have
+// never been on screen, found by a cursor that only moves forward. A
+// completed bar keeps its row until another bar needs it, unless completed
+// bars are hidden. layout() only looks at the bars on screen and the bars
+// touched since the last layout, so its cost follows the height of the
+// terminal, not the number of bars. Callers serialise all calls.
+class Viewport {
 public:
-  void print_progress(bool from_multi_progress = false) {
-    std::lock_guard<std::mutex> lock{mutex_};
+  // The lines available above the cursor, which rests on the row below the
+  // last line. A stream that is not a terminal gets the height of a classic
+  // one.
+  static size_t lines(std::ostream &os) {
+    size_t rows = terminal_size(os).first;
+    if (rows == 0)
+      rows = 24;
+    return (std::max)(rows, size_t(2)) - 1;
+  }
 
-    auto &os = get_value<details::ProgressBarOption::stream>();
+  void resize(size_t count) { state_.resize(count); }
+  void push_back() { state_.push_back(0); }
 
-    if (multi_progress_mode_ && !from_multi_progress) {
+  // Marks bar index as updated since the last layout()
+  void touch(size_t index) {
+    if (state_[index] & touched)
       return;
-    }
-    if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
-      details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
+    state_[index] |= touched;
+    touched_.push_back(index);
+  }
 
-    for (auto &style : get_value<details::ProgressBarOption::font_styles>())
-      details::set_font_style(os, style);
+  // Fits the bars into lines, keeping one line for the summary when they do
+  // not all fit. is_completed(index) tells whether bar index has completed.
+  template <typename IsCompleted>
+  void layout(size_t lines, bool hide_completed, IsCompleted is_completed) {
+    const size_t capacity = state_.size() <= lines ? lines : lines - 1;
+
+    for (auto index : touched_) {
+      state_[index] &= ~touched;
+      count_if_done(index, is_completed);
+    }
+    while (shown_.size() > capacity) {
+      state_[shown_.back()] &= ~shown;
+      shown_.pop_back();
+    }
+    size_t next;
+    for (auto &index : shown_) {
+      count_if_done(index, is_completed);
+      if (is_completed(index) && next_waiting(next, is_completed)) {
+        state_[index] &= ~shown;
+        state_[next] |= shown;
+        index = next;
+      }
+    }
+    if (hide_completed) {
+      shown_.erase(std::remove_if(shown_.begin(), shown_.end(),
+                                  [this, &is_completed](size_t index) {
+                                    if (!is_completed(index))
+                                      return false;
+                                    state_[index] &= ~shown;
+                                    return true;
+                                  }),
+                   shown_.end());
+    }
+    while (shown_.size() < capacity && next_waiting(next, is_completed)) {
+      state_[next] |= shown;
+      shown_.push_back(next);
+    }
+    touched_.clear();
 
-    const auto prefix_pair = get_prefix_text();
-    const auto prefix_text = prefix_pair.first;
-    const auto prefix_length = prefix_pair.second;
-    os << "\r" << prefix_text;
+    size_t shown_done = 0;
+    for (auto index : shown_)
+      shown_done += is_completed(index);
+    hidden_done_ = done_count_ - (std::min)(shown_done, done_count_);
+  }
 
-    os << get_value<details::ProgressBarOption::start>();
+  // The bar on each row, top to bottom
+  const std::vector<size_t> &rows() const { return shown_; }
 
-    details::IndeterminateProgressScaleWriter writer{
-        os, get_value<details::ProgressBarOption::bar_width>(),
-        get_value<details::ProgressBarOption::fill>(),
-        get_value<details::ProgressBarOption::lead>()};
-    writer.write(progress_);
+  size_t hidden() const { return state_.size() - shown_.size(); }
+  size_t hidden_done() const { return hidden_done_; }
 
-    os << get_value<details::ProgressBarOption::end>();
+  // The line that stands for the bars off screen
+  void write_summary(FrameBuffer &line) const {
+    write_unsigned(line << '+', hidden()) << " more (";
+    write_unsigned(line, hidden_done_) << " done)";
+  }
 
-    const auto postfix_pair = get_postfix_text();
-    const auto postfix_text = postfix_pair.first;
-    const auto postfix_length = postfix_pair.second;
-    os << postfix_text;
+private:
+  enum : unsigned char { touched = 1, shown = 2, counted_done = 4 };
 
-    // Get length of prefix text and postfix text
-    const auto start_length = get_value<details::ProgressBarOption::start>().size();
-    const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
-    const auto end_length = get_value<details::ProgressBarOption::end>().size();
-    const auto terminal_width = terminal_size().second;
-    // prefix + bar_width + postfix should be <= terminal_width
-    const int remaining = terminal_width - (prefix_length + start_length + bar_width + end_length + postfix_length);
-    if (prefix_length == -1 || postfix_length == -1) {
-      os << "\r";
-    } else if (remaining > 0) {
-      os << std::string(remaining, ' ') << "\r";
-    } else if (remaining < 0) {
-      // Do nothing. Maybe in the future truncate postfix with ...
+  template <typename IsCompleted> void count_if_done(size_t index, IsCompleted &is_completed) {
+    if (!(state_[index] & counted_done) && is_completed(index)) {
+      state_[index] |= counted_done;
+      ++done_count_;
     }
-    os.flush();
+  }
 
-    if (get_value<details::ProgressBarOption::completed>() &&
-        !from_multi_progress) // Don't std::endl if calling from MultiProgress
-      os << termcolor::reset << std::endl;
+  // The bar to put in a free row: the most recently updated bar that is not
+  // on screen and still running, or else the next bar that has never been on
+  // screen
+  template <typename IsCompleted> bool next_waiting(size_t &next, IsCompleted &is_completed) {
+    while (!touched_.empty()) {
+      next = touched_.back();
+      touched_.pop_back();
+      if (!(state_[next] & shown) && !is_completed(next))
+        return true;
+    }
+    for (; next_unseen_ < state_.size(); ++next_unseen_) {
+      next = next_unseen_;
+      count_if_done(next, is_completed);
+      if (!(state_[next] & shown) && !is_completed(next)) {
+        ++next_unseen_;
+        return true;
+      }
+    }
+    return false;
   }
+
+  std::vector<unsigned char> state_;
+  // The bars on screen, one per row
+  std::vector<size_t> shown_;
+  // The bars updated since the last layout, most recent last
+  std::vector<size_t> touched_;
+  // The first bar that has never been considered for a row
+  size_t next_unseen_{0};
+  size_t done_count_{0};
+  size_t hidden_done_{0};
 };
 
+} // namespace details
 } // namespace indicators
 
 #endif
 
-
-#ifndef INDICATORS_MULTI_PROGRESS
-#define INDICATORS_MULTI_PROGRESS
-#include <atomic>
-#include <functional>
-#include <iostream>
-#include <mutex>
-#include <vector>
-
-// #include <indicators/color.hpp>
-// #include <indicators/cursor_movement.hpp>
-// #include <indicators/details/stream_helper.hpp>
+// #include <indicators/render_scheduler.hpp>
 
 namespace indicators {
 
-template <typename Indicator, size_t count> class MultiProgress {
+// The count of a MultiProgress whose number of bars is only known at run time
+constexpr size_t dynamic_count = static_cast<size_t>(-1);
+
+template <typename Indicator, size_t count = dynamic_count> class MultiProgress {
 public:
   template <typename... Indicators,
             typename = typename std::enable_if<(sizeof...(Indicators) == count)>::type>
@@ -2839,25 +5698,37 @@ public:
     }
   }
 
+  ~MultiProgress() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
+
   template <size_t index>
   typename std::enable_if<(index >= 0 && index < count), void>::type set_progress(size_t value) {
     if (!bars_[index].get().is_completed())
       bars_[index].get().set_progress(value);
-    print_progress();
+    print_progress_if_due();
   }
 
   template <size_t index>
   typename std::enable_if<(index >= 0 && index < count), void>::type set_progress(float value) {
     if (!bars_[index].get().is_completed())
       bars_[index].get().set_progress(value);
-    print_progress();
+    print_progress_if_due();
   }
 
   template <size_t index>
   typename std::enable_if<(index >= 0 && index < count), void>::type tick() {
     if (!bars_[index].get().is_completed())
       bars_[index].get().tick();
-    print_progress();
+    print_progress_if_due();
+  }
+
+  template <size_t index>
+  typename std::enable_if<(index >= 0 && index < count), void>::type advance(size_t n) {
+    if (!bars_[index].get().is_completed())
+      bars_[index].get().advance(n);
+    print_progress_if_due();
   }
 
   template <size_t index>
@@ -2867,8 +5738,47 @@ public:
 
 private:
   std::atomic<bool> started_{false};
+  // Whether a change has not been drawn yet by a frame
+  std::atomic<bool> redraw_pending_{false};
   std::mutex mutex_;
   std::vector<std::reference_wrapper<Indicator>> bars_;
+  details::TerminalFrame frame_;
+
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  // Leaves the frame to the RenderScheduler when attached to it, unless this
+  // update completed the last bar
+  void print_progress_if_due() {
+    if (render_scheduled_ && !_all_completed()) {
+      RenderScheduler::instance().notify(render_pending_);
+      return;
+    }
+    redraw_pending_ = true;
+    draw_pending_frames();
+  }
+
+  // Ticks from many threads share frames instead of queueing for them. The
+  // thread that gets the lock draws frames until no change is pending, each
+  // covering every change made before it began; the others do not wait for
+  // the lock, since their changes are left to the frame being drawn or to
+  // the next one. Checking again after unlocking catches the changes of
+  // threads that found the lock taken just before it was released.
+  //
+  // An update can still wait while a frame formats the line of its own bar:
+  // BlockProgressBar, ProgressSpinner and IndeterminateProgressBar take the
+  // bar's mutex to update it, and so does the tick that completes a
+  // ProgressBar.
+  void draw_pending_frames() {
+    while (redraw_pending_) {
+      std::unique_lock<std::mutex> lock{mutex_, std::try_to_lock};
+      if (!lock.owns_lock())
+        return;
+      while (redraw_pending_.exchange(false))
+        draw_frame();
+    }
+  }
 
   bool _all_completed() {
     bool result{true};
@@ -2877,19 +5787,281 @@ private:
     return result;
   }
 
-public:
-  void print_progress() {
-    std::lock_guard<std::mutex> lock{mutex_};
-    if (started_)
-      move_up(count);
-    for (auto &bar : bars_) {
-      bar.get().print_progress(true);
-      std::cout << "\n";
+  // The first frame draws every bar. Later frames leave the lines of bars
+  // that have not changed alone: the cursor, which rests below the last bar,
+  // moves to each changed line in turn and back down after the last one.
+  // The whole frame goes to the stream of the first bar in one write.
+  void draw_frame() {
+    frame_.begin(bars_[0].get().template get_value<details::ProgressBarOption::stream>());
+    size_t row = started_ ? count : 0;
+    for (size_t i = 0; i < count; ++i) {
+      auto &bar = bars_[i].get();
+      if (started_ && !bar.changed_since_drawn())
+        continue;
+      if (row > i)
+        frame_.move_up(row - i);
+      else if (row < i)
+        frame_.move_down(i - row);
+      bar.append_line(frame_.begin_line());
+      frame_.end_line();
+      row = i + 1;
     }
-    std::cout << termcolor::reset;
+    if (row < count)
+      frame_.move_down(count - row);
+    frame_.end();
     if (!started_)
       started_ = true;
   }
+
+public:
+  // Waits for a frame being drawn by another thread, then draws one
+  void print_progress() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      redraw_pending_ = false;
+      draw_frame();
+    }
+    draw_pending_frames();
+  }
+};
+
+// MultiProgress over a number of bars chosen at run time, for workloads with
+// thousands of tasks. The bars are given as a range of bars or of pointers to
+// bars, and sit in one contiguous array next to a dirty flag each. An update
+// sets the flag of its bar and, the first time only, adds the bar to a list
+// of dirty bars, so that a frame looks at the bars that were updated since
+// the last one and at the rows on screen, never at every bar. A bar that is
+// not updated is not redrawn either, so its elapsed time only moves on with
+// its progress.
+//
+// When there are more bars than terminal rows, the bars share the rows as
+// with option::FitToTerminal in DynamicProgress: the bars that fit are drawn,
+// chosen by details::Viewport, above a summary of the others.
+template <typename Indicator> class MultiProgress<Indicator, dynamic_count> {
+public:
+  template <typename Iterator>
+  MultiProgress(Iterator first, Iterator last)
+      : count_(static_cast<size_t>(std::distance(first, last))), slots_(new Slot[count_]),
+        incomplete_(count_) {
+    for (size_t i = 0; first != last; ++first, ++i) {
+      auto &bar = indicator(*first);
+      bar.multi_progress_mode_ = true;
+      slots_[i].bar = &bar;
+      if (bar.is_completed()) {
+        slots_[i].completed = true;
+        --incomplete_;
+      }
+    }
+    // Each bar is on the list at most once, so neither list ever grows
+    dirty_.reserve(count_);
+    drawing_.reserve(count_);
+    viewport_.resize(count_);
+  }
+
+  ~MultiProgress() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
+
+  size_t size() const { return count_; }
+
+  void set_progress(size_t index, size_t value) {
+    auto &bar = *slots_[index].bar;
+    if (!bar.is_completed())
+      bar.set_progress(value);
+    updated(index);
+  }
+
+  void set_progress(size_t index, float value) {
+    auto &bar = *slots_[index].bar;
+    if (!bar.is_completed())
+      bar.set_progress(value);
+    updated(index);
+  }
+
+  void tick(size_t index) {
+    auto &bar = *slots_[index].bar;
+    if (!bar.is_completed())
+      bar.tick();
+    updated(index);
+  }
+
+  void advance(size_t index, size_t n) {
+    auto &bar = *slots_[index].bar;
+    if (!bar.is_completed())
+      bar.advance(n);
+    updated(index);
+  }
+
+  bool is_completed(size_t index) const { return slots_[index].bar->is_completed(); }
+
+  // Waits for a frame being drawn by another thread, then draws one
+  void print_progress() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      redraw_pending_ = false;
+      draw_frame();
+    }
+    draw_pending_frames();
+  }
+
+private:
+  // Gives every bar its own row if they all fit, or else lays them out with
+  // the viewport. Then walks the rows top to bottom and draws those whose
+  // bar has changed, or was updated and no longer looks the same, and the
+  // summary line if its numbers have changed. The cursor rests below the
+  // last line.
+  void draw_frame() {
+    if (count_ == 0)
+      return;
+    {
+      std::lock_guard<std::mutex> dirty_lock{dirty_mutex_};
+      drawing_.swap(dirty_);
+    }
+    // Cleared before the bars are read, so that an update made while this
+    // frame is drawn puts its bar back on the list for the next one
+    for (auto index : drawing_) {
+      slots_[index].dirty = false;
+      slots_[index].in_frame = true;
+      viewport_.touch(index);
+    }
+
+    auto &os = slots_[0].bar->template get_value<details::ProgressBarOption::stream>();
+    frame_.begin(os);
+    const size_t height = details::Viewport::lines(os);
+    const bool fits = count_ <= height;
+    if (fits) {
+      for (size_t i = all_rows_.size(); i < count_; ++i)
+        all_rows_.push_back(i);
+    } else {
+      viewport_.layout(height, false,
+                       [this](size_t index) { return slots_[index].bar->is_completed(); });
+    }
+    const auto &rows = fits ? all_rows_ : viewport_.rows();
+    const size_t hidden = fits ? 0 : viewport_.hidden();
+    const size_t hidden_done = fits ? 0 : viewport_.hidden_done();
+    const size_t lines = rows.size() + (hidden ? 1 : 0);
+
+    size_t row = drawn_lines_;
+    for (size_t i = 0; i < rows.size(); ++i) {
+      auto &slot = slots_[rows[i]];
+      const bool replaced = i >= drawn_rows_.size() || drawn_rows_[i] != rows[i];
+      if (!replaced && !(slot.in_frame && slot.bar->changed_since_drawn()))
+        continue;
+      move_cursor(row, i);
+      if (replaced && i < drawn_lines_)
+        frame_.erase_line();
+      slot.bar->append_line(frame_.begin_line());
+      frame_.end_line();
+      row = i + 1;
+    }
+    if (hidden) {
+      const size_t i = rows.size();
+      if (i != drawn_rows_.size() || i >= drawn_lines_ || hidden != drawn_hidden_ ||
+          hidden_done != drawn_hidden_done_) {
+        move_cursor(row, i);
+        if (i < drawn_lines_)
+          frame_.erase_line();
+        viewport_.write_summary(frame_.begin_line());
+        frame_.end_line();
+        row = i + 1;
+      }
+    }
+    // Clears what is left of a taller frame
+    for (size_t i = lines; i < drawn_lines_; ++i) {
+      move_cursor(row, i);
+      frame_.erase_line();
+      frame_.end_line();
+      row = i + 1;
+    }
+    move_cursor(row, lines);
+    frame_.end();
+
+    for (auto index : drawing_)
+      slots_[index].in_frame = false;
+    drawing_.clear();
+    drawn_rows_.assign(rows.begin(), rows.end());
+    drawn_lines_ = lines;
+    drawn_hidden_ = hidden;
+    drawn_hidden_done_ = hidden_done;
+  }
+
+  void move_cursor(size_t from, size_t to) {
+    if (from > to)
+      frame_.move_up(from - to);
+    else if (from < to)
+      frame_.move_down(to - from);
+  }
+
+  // Draws frames for the pending changes unless another thread is drawing
+  // them, as in MultiProgress<Indicator, count>
+  void draw_pending_frames() {
+    while (redraw_pending_) {
+      std::unique_lock<std::mutex> lock{mutex_, std::try_to_lock};
+      if (!lock.owns_lock())
+        return;
+      while (redraw_pending_.exchange(false))
+        draw_frame();
+    }
+  }
+
+  struct Slot {
+    Indicator *bar{nullptr};
+    std::atomic<bool> dirty{false};
+    // Whether the bar has been counted out of incomplete_
+    std::atomic<bool> completed{false};
+    // Whether the bar is on the list of the frame being drawn
+    bool in_frame{false};
+  };
+
+  static Indicator &indicator(Indicator &bar) { return bar; }
+  static Indicator &indicator(std::reference_wrapper<Indicator> bar) { return bar.get(); }
+  template <typename Pointer> static Indicator &indicator(Pointer &bar) { return *bar; }
+
+  size_t count_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<size_t> incomplete_;
+  std::atomic<bool> redraw_pending_{false};
+  std::mutex mutex_;
+  details::TerminalFrame frame_;
+
+  // The bars on screen when they do not all fit, the rows when they do, and
+  // what the last frame drew: the bar on each row, the number of lines, and
+  // the numbers on the summary line
+  details::Viewport viewport_;
+  std::vector<size_t> all_rows_;
+  std::vector<size_t> drawn_rows_;
+  size_t drawn_lines_{0};
+  size_t drawn_hidden_{0};
+  size_t drawn_hidden_done_{0};
+
+  // Bars updated since the last frame, in the order of their first update,
+  // and the list that the frame being drawn took over
+  std::mutex dirty_mutex_;
+  std::vector<size_t> dirty_;
+  std::vector<size_t> drawing_;
+
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  // Marks bar index for the next frame and draws it, or leaves it to the
+  // RenderScheduler when attached to it, unless every bar is completed
+  void updated(size_t index) {
+    auto &slot = slots_[index];
+    if (!slot.dirty.exchange(true)) {
+      std::lock_guard<std::mutex> lock{dirty_mutex_};
+      dirty_.push_back(index);
+    }
+    if (slot.bar->is_completed() && !slot.completed.exchange(true))
+      --incomplete_;
+    if (render_scheduled_ && incomplete_ != 0) {
+      RenderScheduler::instance().notify(render_pending_);
+      return;
+    }
+    redraw_pending_ = true;
+    draw_pending_frames();
+  }
 };
 
 } // namespace indicators
@@ -2907,35 +6079,70 @@ public:
 // #include <indicators/cursor_control.hpp>
 // #include <indicators/cursor_movement.hpp>
 // #include <indicators/details/stream_helper.hpp>
+// #include <indicators/details/terminal_frame.hpp>
+// #include <indicators/details/viewport.hpp>
+// #include <indicators/render_scheduler.hpp>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <vector>
 
 namespace indicators {
 
 template <typename Indicator> class DynamicProgress {
-  using Settings = std::tuple<option::HideBarWhenComplete>;
+  using Settings = std::tuple<option::HideBarWhenComplete, option::FitToTerminal>;
 
 public:
-  template <typename... Indicators> explicit DynamicProgress(Indicators &... bars) {
-    bars_ = {bars...};
-    for (auto &bar : bars_) {
-      bar.get().multi_progress_mode_ = true;
+  template <typename... Indicators> explicit DynamicProgress(Indicators &&... bars) {
+    (bars_.emplace_back(std::move(bars)), ...);
+    viewport_.resize(bars_.size());
+    check_state_.resize(bars_.size());
+    for (size_t i = 0; i < bars_.size(); ++i) {
+      bars_[i]->multi_progress_mode_ = true;
       ++total_count_;
       ++incomplete_count_;
+      ++running_count_;
+      check_completed(i);
     }
   }
 
+  ~DynamicProgress() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
+
   Indicator &operator[](size_t index) {
-    print_progress();
+    print_progress_if_due();
     std::lock_guard<std::mutex> lock{mutex_};
-    return bars_[index].get();
+    touch(index);
+    // The caller updates the bar after this returns, so its completion is
+    // checked on a later call
+    if (!(check_state_[index] & unchecked)) {
+      check_state_[index] |= unchecked;
+      unchecked_.push_back(index);
+    }
+    return *bars_[index];
+  }
+
+  void advance(size_t index, size_t n) {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      if (!bars_[index]->is_completed())
+        bars_[index]->advance(n);
+      touch(index);
+      check_completed(index);
+    }
+    print_progress_if_due();
   }
 
-  size_t push_back(Indicator &bar) {
+  size_t push_back(std::unique_ptr<Indicator> bar) {
     std::lock_guard<std::mutex> lock{mutex_};
-    bar.multi_progress_mode_ = true;
-    bars_.push_back(bar);
+    bar->multi_progress_mode_ = true;
+    bars_.push_back(std::move(bar));
+    viewport_.push_back();
+    check_state_.push_back(0);
+    ++running_count_;
+    check_completed(bars_.size() - 1);
     return bars_.size() - 1;
   }
 
@@ -2961,9 +6168,53 @@ private:
   Settings settings_;
   std::atomic<bool> started_{false};
   std::mutex mutex_;
-  std::vector<std::reference_wrapper<Indicator>> bars_;
+  std::vector<std::unique_ptr<Indicator>> bars_;
   std::atomic<size_t> total_count_{0};
   std::atomic<size_t> incomplete_count_{0};
+  details::TerminalFrame frame_;
+
+  // With option::FitToTerminal, the bars on screen and the lines last drawn
+  details::Viewport viewport_;
+  size_t drawn_lines_{0};
+
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
+
+  // Bars handed out by operator[] since their completion was last checked,
+  // and the bars not yet counted as completed, so that telling whether every
+  // bar has completed costs as much as the updates since the last check
+  enum : unsigned char { unchecked = 1, counted_completed = 2 };
+  std::vector<unsigned char> check_state_;
+  std::vector<size_t> unchecked_;
+  std::atomic<size_t> running_count_{0};
+
+  void check_completed(size_t index) {
+    if (!(check_state_[index] & counted_completed) && bars_[index]->is_completed()) {
+      check_state_[index] |= counted_completed;
+      --running_count_;
+    }
+  }
+
+  // Leaves the frame to the RenderScheduler when attached to it, unless every
+  // bar has completed
+  void print_progress_if_due() {
+    if (render_scheduled_) {
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        for (auto index : unchecked_) {
+          check_state_[index] &= ~unchecked;
+          check_completed(index);
+        }
+        unchecked_.clear();
+      }
+      if (running_count_ != 0) {
+        RenderScheduler::instance().notify(render_pending_);
+        return;
+      }
+    }
+    print_progress();
+  }
 
   template <details::ProgressBarOption id>
   auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value)) {
@@ -2976,24 +6227,71 @@ private:
     return details::get_value<id>(settings_).value;
   }
 
+  void draw_line(Indicator &bar) {
+    bar.append_line(frame_.begin_line());
+    frame_.end_line();
+  }
+
+  void touch(size_t index) {
+    if (get_value<details::ProgressBarOption::fit_to_terminal>())
+      viewport_.touch(index);
+  }
+
+  // Draws as many bars as fit above the cursor and a summary of the others,
+  // redrawing all of these lines each time
+  void draw_viewport(std::ostream &os) {
+    viewport_.layout(details::Viewport::lines(os),
+                     get_value<details::ProgressBarOption::hide_bar_when_complete>(),
+                     [this](size_t index) { return bars_[index]->is_completed(); });
+
+    if (started_)
+      frame_.move_up(drawn_lines_);
+    for (auto index : viewport_.rows()) {
+      frame_.erase_line();
+      draw_line(*bars_[index]);
+    }
+    size_t lines_drawn = viewport_.rows().size();
+    if (viewport_.hidden()) {
+      frame_.erase_line();
+      viewport_.write_summary(frame_.begin_line());
+      frame_.end_line();
+      ++lines_drawn;
+    }
+    // Clears what is left of a taller frame
+    for (size_t i = lines_drawn; i < drawn_lines_; ++i) {
+      frame_.erase_line();
+      frame_.end_line();
+    }
+    if (drawn_lines_ > lines_drawn)
+      frame_.move_up(drawn_lines_ - lines_drawn);
+    drawn_lines_ = lines_drawn;
+    if (!started_)
+      started_ = true;
+  }
+
 public:
+  // The whole frame goes to the stream of the first bar in one write
   void print_progress() {
     std::lock_guard<std::mutex> lock{mutex_};
+    auto &os = bars_.empty()
+                   ? std::cout
+                   : bars_[0]->template get_value<details::ProgressBarOption::stream>();
+    frame_.begin(os);
     auto &hide_bar_when_complete = get_value<details::ProgressBarOption::hide_bar_when_complete>();
-    if (hide_bar_when_complete) {
+    if (get_value<details::ProgressBarOption::fit_to_terminal>()) {
+      draw_viewport(os);
+    } else if (hide_bar_when_complete) {
       // Hide completed bars
       if (started_) {
         for (size_t i = 0; i < incomplete_count_; ++i) {
-          move_up(1);
-          erase_line();
-          std::cout << std::flush;
+          frame_.move_up(1);
+          frame_.erase_line();
         }
       }
       incomplete_count_ = 0;
       for (auto &bar : bars_) {
-        if (!bar.get().is_completed()) {
-          bar.get().print_progress(true);
-          std::cout << "\n";
+        if (!bar->is_completed()) {
+          draw_line(*bar);
           ++incomplete_count_;
         }
       }
@@ -3002,16 +6300,14 @@ public:
     } else {
       // Don't hide any bars
       if (started_)
-        move_up(static_cast<int>(total_count_));
-      for (auto &bar : bars_) {
-        bar.get().print_progress(true);
-        std::cout << "\n";
-      }
+        frame_.move_up(total_count_);
+      for (auto &bar : bars_)
+        draw_line(*bar);
       if (!started_)
         started_ = true;
     }
     total_count_ = bars_.size();
-    std::cout << termcolor::reset;
+    frame_.end();
   }
 };
 
@@ -3020,9 +6316,12 @@ public:
 #endif
 
 
+
 #ifndef INDICATORS_PROGRESS_SPINNER
 #define INDICATORS_PROGRESS_SPINNER
 
+// #include <indicators/details/frame_buffer.hpp>
+// #include <indicators/details/redraw_throttle.hpp>
 // #include <indicators/details/stream_helper.hpp>
 
 #include <algorithm>
@@ -3030,6 +6329,7 @@ public:
 #include <chrono>
 #include <cmath>
 // #include <indicators/color.hpp>
+// #include <indicators/render_scheduler.hpp>
 // #include <indicators/setting.hpp>
 #include <iomanip>
 #include <iostream>
@@ -3047,7 +6347,7 @@ class ProgressSpinner {
                  option::ShowPercentage, option::ShowElapsedTime, option::ShowRemainingTime,
                  option::ShowSpinner, option::SavedStartTime, option::Completed,
                  option::MaxPostfixTextLen, option::SpinnerStates, option::FontStyles,
-                 option::MaxProgress, option::Stream>;
+                 option::MaxProgress, option::Stream, option::MinRedrawInterval>;
 
 public:
   template <typename... Args,
@@ -3085,7 +6385,15 @@ public:
             details::get<details::ProgressBarOption::max_progress>(option::MaxProgress{100},
                                                                    std::forward<Args>(args)...),
             details::get<details::ProgressBarOption::stream>(option::Stream{std::cout},
-                                                             std::forward<Args>(args)...)) {}
+                                                             std::forward<Args>(args)...),
+            details::get<details::ProgressBarOption::min_redraw_interval>(
+                option::MinRedrawInterval{std::chrono::nanoseconds::zero()},
+                std::forward<Args>(args)...)) {}
+
+  ~ProgressSpinner() {
+    if (render_scheduled_)
+      RenderScheduler::instance().detach(*this);
+  }
 
   template <typename T, details::ProgressBarOption id>
   void set_option(details::Setting<T, id> &&setting) {
@@ -3094,6 +6402,8 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = std::move(setting).value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
   }
 
   template <typename T, details::ProgressBarOption id>
@@ -3103,6 +6413,8 @@ public:
                   "Setting has wrong type!");
     std::lock_guard<std::mutex> lock(mutex_);
     get_value<id>() = setting.value;
+    if (details::StylePrefix::depends_on(id))
+      style_stale_ = true;
   }
 
   void set_option(
@@ -3130,16 +6442,19 @@ public:
       progress_ = value;
     }
     save_start_time();
-    print_progress();
+    print_progress_if_due(value);
   }
 
-  void tick() {
+  void tick() { advance(1); }
+
+  void advance(size_t n) {
+    size_t value;
     {
       std::lock_guard<std::mutex> lock{mutex_};
-      progress_ += 1;
+      value = progress_ += n;
     }
     save_start_time();
-    print_progress();
+    print_progress_if_due(value);
   }
 
   size_t current() {
@@ -3160,6 +6475,16 @@ private:
   size_t index_{0};
   std::chrono::time_point<std::chrono::high_resolution_clock> start_time_point_;
   std::mutex mutex_;
+  details::RedrawThrottle throttle_;
+  details::FrameBuffer frame_;
+  // Rebuilt before the next frame whenever set_option() changes the colour
+  // or font styles
+  details::StylePrefix style_;
+  bool style_stale_{true};
+
+  friend class RenderScheduler;
+  std::atomic<bool> render_scheduled_{false};
+  std::atomic<bool> render_pending_{false};
 
   template <details::ProgressBarOption id>
   auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value)) {
@@ -3172,6 +6497,21 @@ private:
     return details::get_value<id>(settings_).value;
   }
 
+  // Frames arriving faster than MinRedrawInterval are skipped, and frames of a
+  // spinner attached to the RenderScheduler are left to it; the frame that
+  // reaches MaxProgress is always drawn.
+  void print_progress_if_due(size_t value) {
+    if (value < get_value<details::ProgressBarOption::max_progress>()) {
+      if (render_scheduled_) {
+        RenderScheduler::instance().notify(render_pending_);
+        return;
+      }
+      if (!throttle_.is_due(get_value<details::ProgressBarOption::min_redraw_interval>()))
+        return;
+    }
+    print_progress();
+  }
+
   void save_start_time() {
     auto &show_elapsed_time = get_value<details::ProgressBarOption::show_elapsed_time>();
     auto &show_remaining_time = get_value<details::ProgressBarOption::show_remaining_time>();
@@ -3192,48 +6532,52 @@ public:
     auto now = std::chrono::high_resolution_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_point_);
 
-    if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
-      details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
-
-    for (auto &style : get_value<details::ProgressBarOption::font_styles>())
-      details::set_font_style(os, style);
-
-    os << get_value<details::ProgressBarOption::prefix_text>();
+    frame_.clear();
+    if (style_stale_) {
+      style_.assign(get_value<details::ProgressBarOption::foreground_color>(),
+                    get_value<details::ProgressBarOption::font_styles>());
+      style_stale_ = false;
+    }
+    style_.write(frame_, os);
+    frame_ << get_value<details::ProgressBarOption::prefix_text>();
     if (get_value<details::ProgressBarOption::spinner_show>())
-      os << get_value<details::ProgressBarOption::spinner_states>()
+      frame_ << get_value<details::ProgressBarOption::spinner_states>()
               [index_ % get_value<details::ProgressBarOption::spinner_states>().size()];
     if (get_value<details::ProgressBarOption::show_percentage>()) {
-      os << " " << std::size_t(progress_ / double(max_progress) * 100) << "%";
+      frame_ << ' ';
+      details::write_percentage(frame_, progress_ / double(max_progress) * 100);
     }
 
     if (get_value<details::ProgressBarOption::show_elapsed_time>()) {
-      os << " [";
-      details::write_duration(os, elapsed);
+      frame_ << " [";
+      details::write_duration(frame_, elapsed);
     }
 
     if (get_value<details::ProgressBarOption::show_remaining_time>()) {
       if (get_value<details::ProgressBarOption::show_elapsed_time>())
-        os << "<";
+        frame_ << "<";
       else
-        os << " [";
+        frame_ << " [";
       auto eta = std::chrono::nanoseconds(
           progress_ > 0
               ? static_cast<long long>(std::ceil(float(elapsed.count()) *
                                                  max_progress / progress_))
               : 0);
       auto remaining = eta > elapsed ? (eta - elapsed) : (elapsed - eta);
-      details::write_duration(os, remaining);
-      os << "]";
+      details::write_duration(frame_, remaining);
+      frame_ << "]";
     } else {
       if (get_value<details::ProgressBarOption::show_elapsed_time>())
-        os << "]";
+        frame_ << "]";
     }
 
     if (get_value<details::ProgressBarOption::max_postfix_text_len>() == 0)
       get_value<details::ProgressBarOption::max_postfix_text_len>() = 10;
-    os << " " << get_value<details::ProgressBarOption::postfix_text>()
-       << std::string(get_value<details::ProgressBarOption::max_postfix_text_len>(), ' ') << "\r";
+    frame_ << " " << get_value<details::ProgressBarOption::postfix_text>();
+    frame_.append(get_value<details::ProgressBarOption::max_postfix_text_len>(), ' ') << "\r";
+    frame_.write_to(os);
     os.flush();
+    throttle_.redrawn();
     index_ += 1;
     if (progress_ > max_progress) {
       get_value<details::ProgressBarOption::completed>() = true;
@@ -0,0 +1,100 @@
+#include <indicators/block_progress_bar.hpp>
+#include <indicators/indeterminate_progress_bar.hpp>
+#include <indicators/progress_bar.hpp>
+#include <indicators/progress_spinner.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <streambuf>
+
+// Counts every heap allocation made by the process, so that the frames drawn
+// between two readings can be checked for allocations.
+static std::atomic<size_t> allocations{0};
+
+void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+// Swallows the frames without allocating, unlike a std::ostringstream
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override { return c; }
+  std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+class NullStream : public std::ostream {
+public:
+  NullStream() : std::ostream(&buffer_) {}
+
+private:
+  NullBuffer buffer_;
+};
+
+static const size_t frames = 90;
+
+// Draws frames 0 to frames - 1 once to warm up, then returns the number of
+// allocations made while drawing them all again. draw(i) must draw frame i.
+template <typename Draw> size_t allocations_per_frames(Draw draw) {
+  for (size_t frame = 0; frame < frames; ++frame)
+    draw(frame);
+  const size_t before = allocations;
+  for (size_t frame = 0; frame < frames; ++frame)
+    draw(frame);
+  return allocations - before;
+}
+
+static bool report(const char *indicator, size_t count) {
+  std::printf("%-26s %8zu allocations in %zu frames\n", indicator, count, frames);
+  return count == 0;
+}
+
+int main() {
+  using namespace indicators;
+
+  NullStream stream;
+  bool ok = true;
+
+  {
+    ProgressBar bar{option::BarWidth{100}, option::MaxProgress{100},
+                    option::PrefixText{"Downloading "}, option::PostfixText{"file.bin"},
+                    option::ShowPercentage{true}, option::ShowElapsedTime{true},
+                    option::ShowRemainingTime{true}, option::Stream{stream}};
+    ok &= report("ProgressBar",
+                 allocations_per_frames([&](size_t frame) { bar.set_progress(frame); }));
+  }
+
+  {
+    BlockProgressBar bar{option::BarWidth{100}, option::MaxProgress{100},
+                         option::PrefixText{"Downloading "}, option::PostfixText{"file.bin"},
+                         option::ShowPercentage{true}, option::ShowElapsedTime{true},
+                         option::ShowRemainingTime{true}, option::Stream{stream}};
+    ok &= report("BlockProgressBar",
+                 allocations_per_frames([&](size_t frame) { bar.set_progress(frame); }));
+  }
+
+  {
+    IndeterminateProgressBar bar{option::BarWidth{100}, option::PrefixText{"Checking "},
+                                 option::PostfixText{"file.bin"}, option::Stream{stream}};
+    ok &= report("IndeterminateProgressBar",
+                 allocations_per_frames([&](size_t) { bar.tick(); }));
+  }
+
+  {
+    ProgressSpinner spinner{option::MaxProgress{1000}, option::PostfixText{"file.bin"},
+                            option::ShowPercentage{true}, option::ShowElapsedTime{true},
+                            option::ShowRemainingTime{true}, option::Stream{stream}};
+    ok &= report("ProgressSpinner",
+                 allocations_per_frames([&](size_t) { spinner.tick(); }));
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
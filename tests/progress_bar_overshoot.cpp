@@ -0,0 +1,52 @@
+#include <indicators/progress_bar.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+// Advancing a bar past its end, in either direction, must complete it and
+// leave it showing the end, however far past the end it goes.
+
+static bool check(const char *name, bool ok) {
+  std::printf("%-44s %s\n", name, ok ? "ok" : "FAILED");
+  return ok;
+}
+
+int main() {
+  using namespace indicators;
+
+  std::ostringstream stream;
+  bool ok = true;
+
+  {
+    ProgressBar bar{option::MaxProgress{100}, option::Stream{stream}};
+    bar.advance(60);
+    bar.advance(60);
+    ok &= check("incremental overshoot", bar.is_completed() && bar.current() == 100);
+  }
+
+  {
+    ProgressBar bar{option::MaxProgress{100}, option::ProgressType{ProgressType::decremental},
+                    option::Stream{stream}};
+    bar.advance(60);
+    bar.advance(60);
+    ok &= check("decremental overshoot", bar.is_completed() && bar.current() == 0);
+  }
+
+  {
+    ProgressBar bar{option::MinProgress{10}, option::MaxProgress{100},
+                    option::ProgressType{ProgressType::decremental}, option::Stream{stream}};
+    bar.advance(95);
+    ok &= check("decremental overshoot of MinProgress", bar.is_completed() && bar.current() == 10);
+  }
+
+  {
+    ProgressBar bar{option::MaxProgress{100}, option::ProgressType{ProgressType::decremental},
+                    option::ShardedProgress{true}, option::Stream{stream}};
+    bar.advance(60);
+    bar.advance(60);
+    ok &= check("sharded decremental overshoot", bar.is_completed() && bar.current() == 0);
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
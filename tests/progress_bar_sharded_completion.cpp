@@ -0,0 +1,75 @@
+#include <indicators/progress_bar.hpp>
+#include <indicators/render_scheduler.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A sharded bar must complete, and draw its final frame, on the tick that
+// reaches the end, even when frames are throttled or left to the
+// RenderScheduler, and even when some threads stop ticking early with part
+// of the count still in their slots.
+
+static bool check(const char *name, bool ok) {
+  std::printf("%-44s %s\n", name, ok ? "ok" : "FAILED");
+  return ok;
+}
+
+// Ticks bar from one thread per entry of ticks, each ticking that many times
+static void run(indicators::ProgressBar &bar, const std::vector<size_t> &ticks) {
+  std::vector<std::thread> workers;
+  for (auto count : ticks)
+    workers.emplace_back([&bar, count]() {
+      for (size_t i = 0; i < count; ++i)
+        bar.tick();
+    });
+  for (auto &worker : workers)
+    worker.join();
+}
+
+int main() {
+  using namespace indicators;
+
+  const std::vector<size_t> ticks{10, 990, 500, 500};
+  const size_t total = 2000;
+  bool ok = true;
+
+  {
+    std::ostringstream stream;
+    ProgressBar bar{option::MaxProgress{total}, option::ShardedProgress{true},
+                    option::MinRedrawInterval{std::chrono::seconds(10)},
+                    option::ShowPercentage{true}, option::Stream{stream}};
+    run(bar, ticks);
+    ok &= check("throttled", bar.is_completed() && bar.current() == total &&
+                                 stream.str().find("100%") != std::string::npos);
+  }
+
+  {
+    std::ostringstream stream;
+    ProgressBar bar{option::MaxProgress{total}, option::ProgressType{ProgressType::decremental},
+                    option::ShardedProgress{true},
+                    option::MinRedrawInterval{std::chrono::seconds(10)}, option::Stream{stream}};
+    run(bar, ticks);
+    ok &= check("throttled, decremental", bar.is_completed() && bar.current() == 0);
+  }
+
+  {
+    std::ostringstream stream;
+    ProgressBar bar{option::MaxProgress{total}, option::ShardedProgress{true},
+                    option::ShowPercentage{true}, option::Stream{stream}};
+    RenderScheduler::instance().set_frame_rate(1);
+    RenderScheduler::instance().attach(bar);
+    run(bar, ticks);
+    // The completing thread has drawn the final frame by now
+    const bool completed = bar.is_completed();
+    RenderScheduler::instance().detach(bar);
+    ok &= check("on the RenderScheduler", completed && bar.current() == total &&
+                                              stream.str().find("100%") != std::string::npos);
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+# coding=utf-8
+
+"""Generates include/indicators/details/width_table.hpp, the two-stage table
+that unicode::details::mk_wcwidth() and mk_wcwidth_cjk() look up the column
+width of a code point in.
+
+Every code point gets a two-bit width class: 0 for zero width, 1 for narrow,
+2 for wide and 3 for East Asian Ambiguous, which is narrow except in the CJK
+variant. The classes are packed four to a byte in leaves of a page of code
+points, identical leaves are stored once, and a page index maps the upper
+bits of a code point to its leaf. A lookup is two array reads. The page size is
+whichever power of two makes the two arrays smallest.
+
+C0/C1 control characters are not in the table; mk_wcwidth() tests for them
+before looking a code point up.
+
+Usage: python3 utils/width_table/generate_width_table.py --ucd DIR [output]
+
+The table is generated from the data files of a Unicode release in DIR, e.g.
+an unpacked https://www.unicode.org/Public/<version>/ucd/, and records the
+version named in those files. The checked-in table is generated from Unicode
+16.0.0. The data that ships with Python is not used, since its version
+depends on the Python that runs the script.
+"""
+
+import argparse
+import os
+import re
+
+# The rules follow Markus Kuhn's wcwidth.c, applied to the data of the Unicode
+# Character Database instead of his Unicode 5.0 tables:
+#
+#  - Non-spacing and enclosing marks (Mn, Me) and format characters (Cf)
+#    other than SOFT HYPHEN are zero width, and so are the Hangul Jamo medial
+#    vowels and final consonants.
+#  - East Asian Wide (W) and Fullwidth (F) characters are two columns wide.
+#    Since Unicode 9 this includes every emoji with emoji presentation.
+#    Unassigned code points in the CJK ideograph blocks and planes 2 and 3
+#    default to wide, as UAX #11 specifies.
+#  - Regional indicators are two columns wide: a pair of them is drawn as one
+#    flag, which display_width() counts once.
+#  - East Asian Ambiguous (A) characters are ambiguous, everything else is
+#    narrow.
+
+ZERO, NARROW, WIDE, AMBIGUOUS = 0, 1, 2, 3
+
+CODE_POINTS = 0x110000
+
+HANGUL_JAMO_MEDIALS_AND_FINALS = [(0x1160, 0x11FF), (0xD7B0, 0xD7FF)]
+
+WIDE_BY_DEFAULT = [(0x3400, 0x4DBF), (0x4E00, 0x9FFF), (0xF900, 0xFAFF),
+                   (0x20000, 0x2FFFD), (0x30000, 0x3FFFD)]
+
+REGIONAL_INDICATORS = (0x1F1E6, 0x1F1FF)
+
+
+class UnicodeDataFiles:
+    """EastAsianWidth.txt and extracted/DerivedGeneralCategory.txt of a
+    Unicode release"""
+
+    def __init__(self, directory):
+        self.version = None
+        self.categories = self.load(directory, "DerivedGeneralCategory.txt", "Cn")
+        self.widths = self.load(directory, "EastAsianWidth.txt", "N")
+
+    def load(self, directory, name, default):
+        for path in (os.path.join(directory, name),
+                     os.path.join(directory, "extracted", name)):
+            if os.path.exists(path):
+                break
+        values = [default] * CODE_POINTS
+        with open(path, encoding="utf-8") as data:
+            lines = data.readlines()
+        # Code points that no line lists take the value of the last
+        # "# @missing:" line that covers them, e.g. W for the unassigned code
+        # points of the CJK ideograph blocks
+        missing = [line.split(":", 1)[1] for line in lines
+                   if line.startswith("# @missing:")]
+        listed = [line.split("#", 1)[0] for line in lines]
+        for line in missing + listed:
+            line = line.strip()
+            if not line:
+                continue
+            code_points, value = (field.strip() for field in line.split(";"))
+            first, _, last = code_points.partition("..")
+            for ucs in range(int(first, 16), int(last or first, 16) + 1):
+                values[ucs] = value
+        for line in lines:
+            match = re.match(r"# \w+-(\d+\.\d+\.\d+)\.txt", line)
+            if match:
+                self.version = match.group(1)
+                break
+        if self.version is None:
+            raise SystemExit("%s names no Unicode version" % path)
+        return values
+
+    def category(self, ucs):
+        return self.categories[ucs]
+
+    def east_asian_width(self, ucs):
+        return self.widths[ucs]
+
+
+def in_ranges(ucs, ranges):
+    return any(first <= ucs <= last for first, last in ranges)
+
+
+def width_classes(ucd):
+    classes = [NARROW] * CODE_POINTS
+    for ucs in range(CODE_POINTS):
+        category = ucd.category(ucs)
+        width = ucd.east_asian_width(ucs)
+        if (category in ("Mn", "Me") or (category == "Cf" and ucs != 0x00AD) or
+                in_ranges(ucs, HANGUL_JAMO_MEDIALS_AND_FINALS)):
+            classes[ucs] = ZERO
+        elif width in ("W", "F") or in_ranges(ucs, [REGIONAL_INDICATORS]):
+            classes[ucs] = WIDE
+        elif category == "Cn" and in_ranges(ucs, WIDE_BY_DEFAULT):
+            classes[ucs] = WIDE
+        elif width == "A":
+            classes[ucs] = AMBIGUOUS
+    return classes
+
+
+def build_table(classes, page_shift):
+    """Returns the page index and the leaves for pages of 1 << page_shift code
+    points, or None if there are too many distinct leaves to index in a byte"""
+    page_size = 1 << page_shift
+    pages, leaves, leaf_index = [], [], {}
+    for start in range(0, CODE_POINTS, page_size):
+        leaf = bytes(
+            classes[i] | classes[i + 1] << 2 | classes[i + 2] << 4 | classes[i + 3] << 6
+            for i in range(start, start + page_size, 4))
+        if leaf not in leaf_index:
+            leaf_index[leaf] = len(leaves)
+            leaves.append(leaf)
+        pages.append(leaf_index[leaf])
+    if len(leaves) > 256:
+        return None
+    return pages, b"".join(leaves)
+
+
+def smallest_table(classes):
+    best = None
+    for page_shift in range(6, 13):
+        table = build_table(classes, page_shift)
+        if table and (best is None or len(table[0]) + len(table[1]) < best[1]):
+            best = (page_shift, len(table[0]) + len(table[1]), table)
+    return best[0], best[2]
+
+
+def format_array(values, indent="      "):
+    lines, line = [], indent
+    for value in values:
+        item = "0x%02x," % value
+        if len(line) + len(item) + 1 > 80:
+            lines.append(line.rstrip())
+            line = indent
+        line += item + " "
+    lines.append(line.rstrip())
+    return "\n".join(lines)
+
+
+HEADER = """
+// Generated by utils/width_table/generate_width_table.py from Unicode
+// %(version)s -- do not edit.
+
+#ifndef INDICATORS_WIDTH_TABLE
+#define INDICATORS_WIDTH_TABLE
+
+namespace unicode {
+
+namespace details {
+
+// Two-bit width class of every code point (0 zero width, 1 narrow, 2 wide,
+// 3 East Asian Ambiguous), four to a byte in leaves of %(page_size)d code points.
+// pages[ucs >> %(shift)d] is the index of the leaf that holds ucs. Defined in a
+// class template so that every translation unit shares one copy. %(bytes)d bytes.
+template <typename = void> struct width_table {
+  static constexpr unsigned char pages[%(page_count)d] = {
+%(pages)s
+  };
+  static constexpr unsigned char leaves[%(leaf_bytes)d] = {
+%(leaves)s
+  };
+};
+
+template <typename T> constexpr unsigned char width_table<T>::pages[];
+template <typename T> constexpr unsigned char width_table<T>::leaves[];
+
+// Width class of ucs; code points beyond U+10FFFF are narrow
+constexpr int width_class(char32_t ucs) {
+  return ucs > 0x10ffff ? 1
+                        : (width_table<>::leaves[width_table<>::pages[ucs >> %(shift)d] * %(leaf_size)d +
+                                                 (ucs & 0x%(mask)x) / 4] >>
+                           (ucs %% 4 * 2)) &
+                              3;
+}
+
+} // namespace details
+
+} // namespace unicode
+
+#endif
+"""
+
+
+def main():
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..")
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--ucd", metavar="DIR", required=True,
+                        help="directory with EastAsianWidth.txt and DerivedGeneralCategory.txt")
+    parser.add_argument("output", nargs="?",
+                        default=os.path.join(root, "include", "indicators", "details",
+                                             "width_table.hpp"))
+    args = parser.parse_args()
+
+    ucd = UnicodeDataFiles(args.ucd)
+    page_shift, (pages, leaves) = smallest_table(width_classes(ucd))
+    page_size = 1 << page_shift
+    header = HEADER % {
+        "version": ucd.version,
+        "page_size": page_size,
+        "shift": page_shift,
+        "mask": page_size - 1,
+        "leaf_size": page_size // 4,
+        "page_count": len(pages),
+        "leaf_bytes": len(leaves),
+        "bytes": len(pages) + len(leaves),
+        "pages": format_array(pages),
+        "leaves": format_array(leaves),
+    }
+    with open(args.output, "w", newline="\n") as output:
+        output.write(header)
+
+
+if __name__ == "__main__":
+    main()